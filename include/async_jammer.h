@@ -28,6 +28,12 @@ public:
     int get_current_state() const { return _current_state; }
     float get_frequency_offset() const { return _frequency_offset; }
     
+    // Scheduling: step_jammer() has nothing to do before get_next_event_time()
+    // (the earlier of the next state change and the next brownian drift step)
+    // A next event time of 0 means transmission starts on the next step
+    bool is_running() const { return _active && _initialized; }
+    unsigned long get_next_event_time() const;
+    
 private:
     void apply_brownian_drift();
     void apply_boundary_enforcement();
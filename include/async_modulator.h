@@ -35,12 +35,18 @@ public:
     void set_switched_on(bool switched_on) { async_switched_on = switched_on; }
     bool is_switched_on() const { return async_switched_on; }
     
+    // ========================================
+    // SCHEDULING
+    // ========================================
+    // Time of the next state change; step_modulator() calls before then are no-ops
+    // Only meaningful while is_transmission_complete() is false
+    unsigned long get_next_event_time() const { return async_next_event; }
+    
 protected:    // ========================================
     // COMMON TIMING HELPERS
     // ========================================
     bool is_time_ready(unsigned long current_time) const;
     void set_next_event_time(unsigned long time);
-    unsigned long get_next_event_time() const { return async_next_event; }
     
     // ========================================
     // COMMON OUTPUT CONTROL
@@ -76,6 +82,17 @@ protected:    // ========================================
     void set_current_element(byte element) { async_element = element; }
     void advance_element() { async_element++; }
     
+    // ========================================
+    // PER-MODULATOR RANDOM NUMBERS
+    // ========================================
+    // With ENABLE_MODULATION_TICK the modulator steps inside the tick ISR,
+    // where random() must not run: avr-libc's random() state is shared with
+    // the main loop and not reentrant. Each modulator draws from its own
+    // xorshift16 instead, reseeded from random() by seed_random() when a
+    // message starts (main loop, keyer held).
+    void seed_random();
+    uint16_t next_random(uint16_t range);    // 0 .. range - 1
+    
 private:
     // ========================================
     // COMMON STATE VARIABLES
@@ -95,6 +112,8 @@ private:
     // Output state tracking
     bool async_active;               // True when transmitter should be ON
     bool async_switched_on;          // Tracks output transitions for TURN_ON/TURN_OFF
+    
+    uint16_t async_prng;             // xorshift16 state, never 0
 };
 
 #endif // __ASYNC_MODULATOR_H__
@@ -32,6 +32,11 @@ public:
     int step_pager(unsigned long time);
     int get_current_state() { return _current_state; }
     
+    // Scheduling: step_pager() has nothing to do before get_next_event_time()
+    // A next event time of 0 means the first tone starts on the next step
+    bool is_running() const { return _active && _initialized; }
+    unsigned long get_next_event_time() const { return _next_event_time; }
+    
 private:
     void start_next_phase(unsigned long time);
     unsigned long get_random_silence_duration();
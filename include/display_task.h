@@ -0,0 +1,55 @@
+#ifndef __DISPLAY_TASK_H__
+#define __DISPLAY_TASK_H__
+
+#include <Arduino.h>
+#include <HT16K33Disp.h>
+
+// Display task - cooperative, queued text for the HT16K33 display
+//
+// HT16K33Disp::scroll_string() spins until the whole scroll is done, and
+// for all of that time no station steps, so Morse and RTTY keying froze
+// whenever a title scrolled. The display task scrolls instead from step(),
+// called once per main loop pass, one frame at a time.
+//
+// queue() adds a message (startup banner, application and mode titles) that
+// plays to the end in turn. show() sets the text to leave on the display -
+// a VFO frequency, an option value: it replaces a show() text still waiting
+// behind a title, and shows straight away when nothing is playing.
+//
+// Text is copied into the task, so callers can pass the shared string
+// buffers. When the queue is full the newest message replaces the last one.
+
+#define DISPLAY_TASK_QUEUE 4
+#define DISPLAY_TASK_TEXT 13            // same as display_text_buffer
+
+class DisplayTask
+{
+public:
+    DisplayTask(HT16K33Disp *display);
+
+    void queue(const char *text, int show_delay = 0, int scroll_delay = 0);
+    void show(const char *text, int show_delay = 1, int scroll_delay = 1);
+    void clear();                       // drop everything queued
+
+    bool step(unsigned long time);      // returns true while a message is playing
+    bool is_busy() const { return _count > 0; }
+
+private:
+    struct Message {
+        char text[DISPLAY_TASK_TEXT];
+        int show_delay;
+        int scroll_delay;
+        bool replaceable;               // from show()
+    };
+
+    Message *add(const char *text, int show_delay, int scroll_delay, bool replaceable);
+    Message &last() { return _messages[(_first + _count - 1) % DISPLAY_TASK_QUEUE]; }
+
+    HT16K33Disp *_display;
+    Message _messages[DISPLAY_TASK_QUEUE];
+    byte _first;
+    byte _count;
+    bool _started;                      // first message has been handed to the display
+};
+
+#endif // __DISPLAY_TASK_H__
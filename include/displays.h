@@ -2,6 +2,7 @@
 #define __DISPLAY_H__
 
 #include <HT16K33Disp.h>
+#include "display_task.h"
 
 #define DISPLAY_BRIGHTNESS1 3 // Red needs maximum brightness to match minimum Emerald Green brightness
 #define DISPLAY_BRIGHTNESS2 3 // Red needs maximum brightness to match minimum Emerald Green brightness
@@ -9,4 +10,7 @@
 // main 8 digit full display representing both physical displays
 extern HT16K33Disp display;
 
+// queued, non-blocking text for the display, stepped from the main loop
+extern DisplayTask display_task;
+
 #endif
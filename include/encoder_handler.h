@@ -3,6 +3,8 @@
 
 #include <Arduino.h>
 #include <limits.h>
+#include "station_config.h"
+#include "input_capture.h"
 
 #define UNPRESSED 0
 #define PRESSED 1
@@ -24,18 +26,36 @@ public:
 
     pinMode(_button_pin, INPUT_PULLUP);
 
+#ifdef ENABLE_INPUT_CAPTURE
+    // the pin change interrupt decodes the encoder, see input_capture.h
+    pencoder = NULL;
+    if(clock_pin != 0 && data_pin != 0)
+      InputCapture::attach(id, this, clock_pin, data_pin, button_pin, pulses_per_detent);
+    _press_time = 0;
+#else
     if(clock_pin != 0 && data_pin != 0)
       pencoder = new Encoder(clock_pin, data_pin);
     else
       pencoder = NULL;
+#endif
 
     _changed = false;
     _pressed = false;
     _long_pressed = false;
     _diff = 0;
+#ifdef ENABLE_TUNING_LATENCY
+    _detent_time = 0;
+#endif
   }
 
   void step(){
+#ifdef ENABLE_INPUT_CAPTURE
+    if(InputCapture::is_running()){
+      InputCapture::drain();
+      step_captured_button();
+      return;
+    }
+#endif
     switch(button_state){
       case UNPRESSED:
         if(digitalRead(_button_pin) == LOW){
@@ -75,15 +95,15 @@ public:
     if(pencoder != NULL){    
       long new_dial_position = pencoder->read();
       if (new_dial_position != old_dial_position) {
-        int diff = new_dial_position - old_dial_position;
         old_dial_position = new_dial_position;
-          if(diff != 0){
-          long new_encoded_position = new_dial_position / _pulses_per_detent;
-          if(new_encoded_position != old_encoded_position){
-            old_encoded_position = new_encoded_position;
-            // Normalize diff to ±1 regardless of pulses_per_detent value
-            send(diff > 0 ? 1 : -1);      
-          }
+        long new_encoded_position = new_dial_position / _pulses_per_detent;
+        if(old_encoded_position == LONG_MIN){
+          // first reading, nothing to compare against yet
+          old_encoded_position = new_encoded_position;
+        } else if(new_encoded_position != old_encoded_position){
+          // every detent turned since the last pass, in one signed count
+          add_detents(new_encoded_position - old_encoded_position);
+          old_encoded_position = new_encoded_position;
         }
       }
     }
@@ -95,13 +115,7 @@ public:
     switch(diff){
       case -1:
       case 1:
-        if(_changed){
-          // the latest has not been seen, accumulate the diff
-          _diff += diff;
-        } else {
-          _changed = true;
-          _diff = diff;
-        }
+        add_detents(diff);
         break;
 
       case 0:
@@ -112,21 +126,83 @@ public:
         _long_pressed = true;
         break;
     }
+  }
 
+  // detents is the signed number of detents turned, CW positive;
+  // time is the micros() they were seen at
+  void add_detents(long detents, unsigned long time){
+    if(_changed){
+      // the latest has not been seen, accumulate the diff
+      _diff += detents;
+    } else {
+      _changed = true;
+      _diff = detents;
+#ifdef ENABLE_TUNING_LATENCY
+      // first detent of the batch, the one that has waited longest
+      _detent_time = time;
+#endif
+    }
+  }
 
+  void add_detents(long detents){
+    add_detents(detents, micros());
+  }
 
-// accumulate the diffs while changed = true
+#ifdef ENABLE_INPUT_CAPTURE
+  // a button edge from InputCapture::drain(), time in micros()
+  void captured_button(bool down, unsigned long time){
+    if(down){
+      if(button_state == UNPRESSED){
+        _press_time = time;
+        button_state = PRESSED;
+      }
+    } else {
+      if(button_state == PRESSED && time - _press_time >= DEBOUNCE_TIME * 1000UL){
+        // held past the debounce but released before the loop came round
+        send(0);
+      }
+      button_state = UNPRESSED;
+    }
+  }
 
+  // the debounce and repeat timeouts of a button that is still down
+  void step_captured_button(){
+    switch(button_state){
+      case PRESSED:
+        if(micros() - _press_time >= DEBOUNCE_TIME * 1000UL){
+          send(0);
+          valid_time = millis() + REPEAT_TIME;
+          button_state = NOTIFIED_PRESSED;
+        }
+        break;
+      case NOTIFIED_PRESSED:
+        if(millis() >= valid_time){
+          send(2);
+          valid_time = millis() + REPEAT_TIME;
+        }
+        break;
+    }
   }
+#endif
+
   bool changed(){
     return _changed;
   }
 
+  // signed count of all the detents since the last call, so the caller
+  // handles a fast spin as one event rather than one per detent
   int diff(){
     _changed = false;
     return _diff;
   }
 
+#ifdef ENABLE_TUNING_LATENCY
+  // micros() when the first detent of the pending diff was seen
+  unsigned long detent_time(){
+    return _detent_time;
+  }
+
+#endif
   int pressed(){
     bool ret = _pressed;
     _pressed = false;
@@ -157,6 +233,12 @@ private:
   bool _pressed;
   bool _long_pressed;
   int _diff;
+#ifdef ENABLE_TUNING_LATENCY
+  unsigned long _detent_time;
+#endif
+#ifdef ENABLE_INPUT_CAPTURE
+  unsigned long _press_time;    // micros() of the button edge being debounced
+#endif
 };
 
 #endif
@@ -0,0 +1,118 @@
+#ifndef __INPUT_CAPTURE_H__
+#define __INPUT_CAPTURE_H__
+
+#include <Arduino.h>
+#include "station_config.h"
+
+// Interrupt-driven encoder and button capture
+//
+// Without it, EncoderHandler::step() polls the buttons with digitalRead() and
+// millis() and reads Encoder::read() once per loop pass, so a press shorter
+// than a slow pass (a blocking scroll_string, a NeoPixel show(), a busy
+// station pass) can be missed and every press is only seen when the loop
+// comes round.
+//
+// With ENABLE_INPUT_CAPTURE a pin change interrupt on each encoder's clock,
+// data and button lines decodes the quadrature in the ISR (same state table
+// as paulstoffregen/Encoder) and pushes timestamped detent and button edge
+// events into a single-producer/single-consumer ring. EncoderHandler::step()
+// drains the ring: detents go into the usual diff() batch with the time of
+// the first one, button edges run the debounce against their own timestamps,
+// so a press is measured from when it happened rather than when it was seen.
+//
+// If the ring fills, detents are still counted per channel and the latest
+// button level is kept, and drain() hands both over after the queued events,
+// so input is delayed at worst, never lost.
+//
+// Interrupt source:
+// - ATmega328 (Nano):   pin change interrupts (PCINT); the encoder pins 2-7
+//                       are all on PORTD, so one PCINT2 vector serves both
+// - ATmega4809 (Every): attachInterrupt(CHANGE) on each pin - every pin has one
+// - Host builds:        the shim's attachInterrupt(); native_set_pin() and
+//                       native_turn_encoder() (after native_set_encoder_pins())
+//                       fire it
+//
+// USAGE:
+// 1. Uncomment ENABLE_INPUT_CAPTURE in station_config.h (~120 bytes RAM, less
+//    the two Encoder objects it replaces)
+// 2. InputCapture::begin() at the end of setup() enables the interrupts
+//
+// EncoderHandler registers its pins when constructed; until begin() runs only
+// the buttons are polled.
+
+#ifdef ENABLE_INPUT_CAPTURE
+
+#define INPUT_CAPTURE_CHANNELS 2
+
+#ifndef INPUT_CAPTURE_RING_SIZE
+#define INPUT_CAPTURE_RING_SIZE 16      // power of two
+#endif
+
+// Event codes, low two bits; the channel is in the bits above
+#define INPUT_EVENT_DETENT_CW   0
+#define INPUT_EVENT_DETENT_CCW  1
+#define INPUT_EVENT_BUTTON_DOWN 2
+#define INPUT_EVENT_BUTTON_UP   3
+
+class EncoderHandler;
+
+class InputCapture
+{
+public:
+    // called by the EncoderHandler constructor
+    static void attach(byte channel, EncoderHandler *handler, uint8_t clock_pin, uint8_t data_pin,
+                       uint8_t button_pin, byte pulses_per_detent);
+
+    static void begin();                // start the pin change interrupts
+    static void drain();                // main loop: hand queued events to the handlers
+    static bool is_running() { return _running; }
+
+    static void service(byte channel);  // ISR body: sample one channel's pins
+
+    static unsigned int get_overflow_count() { return _overflows; }
+
+private:
+    struct InputEvent {
+        unsigned long time;             // micros()
+        uint8_t code;                   // channel << 2 | INPUT_EVENT_*
+    };
+
+    struct Channel {
+        EncoderHandler *handler;
+        uint8_t clock_pin;
+        uint8_t data_pin;
+        uint8_t button_pin;
+        byte pulses_per_detent;
+#ifndef NATIVE_BUILD
+        volatile uint8_t *clock_reg;
+        volatile uint8_t *data_reg;
+        volatile uint8_t *button_reg;
+        uint8_t clock_mask;
+        uint8_t data_mask;
+        uint8_t button_mask;
+#endif
+        uint8_t quad_state;             // last clock/data levels, clock in bit 0
+        int8_t pulses;                  // quadrature steps toward the next detent
+        bool button_down;               // last button level captured
+        volatile int lost_detents;      // detents that found the ring full
+        volatile bool lost_button;      // a button edge found the ring full
+    };
+
+    static void push(byte channel, uint8_t event, unsigned long time);
+    static uint8_t read_pins(const Channel &channel);
+
+    static volatile InputEvent _ring[INPUT_CAPTURE_RING_SIZE];
+    static volatile uint8_t _head;      // written by the ISR
+    static volatile uint8_t _tail;      // written by drain()
+    static Channel _channels[INPUT_CAPTURE_CHANNELS];
+    static unsigned int _overflows;
+    static bool _running;
+
+public:
+    static const size_t STATIC_BYTES = sizeof(_ring) + sizeof(_channels) + 2 * sizeof(uint8_t) +
+                                       sizeof(unsigned int) + sizeof(bool);
+};
+
+#endif // ENABLE_INPUT_CAPTURE
+
+#endif // __INPUT_CAPTURE_H__
@@ -0,0 +1,79 @@
+#ifndef __LOOP_PROFILER_H__
+#define __LOOP_PROFILER_H__
+
+#include <Arduino.h>
+#include "station_config.h"
+
+// Main loop profiler - micros() timing of each phase of the loop() pass
+//
+// Each phase keeps a log2 histogram (bucket n counts durations of 2^n..2^(n+1)-1 us,
+// bucket 0 also counts 0 us) plus min/max, so p99 can be read back to within a
+// factor of two without storing samples. Buckets are 16 bits; when one fills up
+// the whole phase is halved, keeping the shape of the distribution.
+//
+// USAGE:
+// 1. Uncomment ENABLE_LOOP_PROFILER in station_config.h (~360 bytes RAM)
+// 2. Open the serial monitor and send 'p' to print the table, 'r' to reset it
+//
+// Phases are contiguous: end_phase() charges the time since the previous
+// end_phase() (or begin_pass()) to the given phase.
+
+#define LOOP_PHASE_SIGNAL_METER     0   // signal_meter.update()
+#define LOOP_PHASE_STATION_MANAGER  1   // station_manager.updateStations()
+#define LOOP_PHASE_PANEL_LED        2   // analogWrite() panel lock LED override
+#define LOOP_PHASE_REALIZATION_POOL 3   // realization_pool.step() - all station step() calls
+#define LOOP_PHASE_ENCODERS         4   // encoder_handlerA/B.step()
+#define LOOP_PHASE_TITLE_DISPLAY    5   // display_task.step(), dispatcher->step_title_display()
+#define LOOP_PHASE_DISPATCH         6   // application switch and encoder event dispatch
+#define LOOP_PHASE_TOTAL            7   // whole pass
+#define LOOP_PROFILER_PHASES        8
+
+#define LOOP_PROFILER_BUCKETS 16        // up to 32.7 ms, longer durations land in the last bucket
+
+class LoopProfiler
+{
+public:
+    LoopProfiler();
+
+    void begin_pass();
+    void end_phase(byte phase);
+    void end_pass();
+
+    void record(byte phase, unsigned long duration);
+    void reset();
+
+    // Serial interface: 'p' prints the table, 'r' resets it;
+    // returns false for commands it does not handle
+    bool handle_command(char command);
+    void dump();
+
+    unsigned long get_count(byte phase) const { return _count[phase]; }
+    unsigned long get_min(byte phase) const { return _count[phase] ? _min[phase] : 0; }
+    unsigned long get_max(byte phase) const { return _max[phase]; }
+    unsigned long get_percentile(byte phase, byte percent) const;  // upper bound of the bucket holding the percentile
+
+private:
+    static byte bucket_for(unsigned long duration);
+    static void print_phase_name(byte phase);
+
+    uint16_t _buckets[LOOP_PROFILER_PHASES][LOOP_PROFILER_BUCKETS];
+    unsigned long _count[LOOP_PROFILER_PHASES];
+    unsigned long _min[LOOP_PROFILER_PHASES];
+    unsigned long _max[LOOP_PROFILER_PHASES];
+    unsigned long _pass_start;
+    unsigned long _phase_start;
+};
+
+#ifdef ENABLE_LOOP_PROFILER
+extern LoopProfiler loop_profiler;
+
+#define PROFILE_BEGIN_PASS()   loop_profiler.begin_pass()
+#define PROFILE_PHASE(phase)   loop_profiler.end_phase(phase)
+#define PROFILE_END_PASS()     loop_profiler.end_pass()
+#else
+#define PROFILE_BEGIN_PASS()
+#define PROFILE_PHASE(phase)
+#define PROFILE_END_PASS()
+#endif
+
+#endif // __LOOP_PROFILER_H__
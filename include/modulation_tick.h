@@ -0,0 +1,99 @@
+#ifndef __MODULATION_TICK_H__
+#define __MODULATION_TICK_H__
+
+#include <Arduino.h>
+#include "station_config.h"
+#include "async_modulator.h"
+#include "wavegen.h"
+
+// Hardware-timer modulation tick - Morse and RTTY element timing off the main loop
+//
+// Without the tick, a station's modulator only advances when the main loop
+// reaches realization_pool.step(), so every element edge is late by whatever
+// the slowest phase of that pass cost (NeoPixel show(), HT16K33 writes,
+// a blocking scroll_string). RTTY's 22 ms bits jitter by that much.
+//
+// With ENABLE_MODULATION_TICK a periodic timer interrupt steps each station's
+// modulator every MODULATION_TICK_US and, on TURN_ON/TURN_OFF, flips the
+// AD9833's FSELECT through WaveGen::key() straight away. The station's own
+// step() in the main loop then reads the keyer instead of the modulator:
+// ModulationKeyer::step() reports the latest on/off change and a latched
+// message completion as the usual STEP_* codes, so the station logic
+// (charge pulses, wait delays, pipelining) is unchanged and simply runs
+// a little later than the audio.
+//
+// Timer used for the tick:
+// - ATmega328 (Nano):   Timer2 compare A, CTC at 1 kHz (Timer2 PWM pins 3/11
+//                       are the encoder A clock and AD9833 DATA, never PWM)
+// - ATmega4809 (Every): TCB2 periodic interrupt; override MODULATION_TICK_TCB
+//                       to move it (TCB3 is millis(), TCB0/1 PWM pins 6/3)
+// - Host builds:        native_attach_tick() fires the ISR as the virtual
+//                       clock advances, so host tools see the same timing
+//
+// While is_keying(), realize() leaves the FSELECT alone: the station's
+// _active trails the ISR, so staging it could undo a flip the ISR just made.
+//
+// Main loop code that changes a modulator (start_morse(), start_rtty_message())
+// brackets the change with hold()/release() so the ISR never steps a
+// modulator mid-update.
+//
+// USAGE:
+// 1. Uncomment ENABLE_MODULATION_TICK in station_config.h
+//    (~9 bytes RAM per Morse/RTTY station, 3 per wave generator)
+// 2. ModulationKeyer::begin() at the end of setup() starts the timer
+//
+// Until begin() runs (or with the flag off), and whenever no generator is
+// attached, step() polls the modulator directly, exactly as before.
+
+#define MODULATION_TICK_US 1000
+
+#ifndef MODULATION_TICK_TCB
+#define MODULATION_TICK_TCB 2
+#endif
+
+class ModulationKeyer
+{
+public:
+    ModulationKeyer(AsyncModulator *modulator);
+
+    // main loop: next STEP_* code for the station
+    int step(unsigned long time);
+
+#ifdef ENABLE_MODULATION_TICK
+    // Generator the ISR keys, NULL while not realized; a newly attached
+    // one is set to the modulator's current carrier state
+    void set_output(WaveGen *wavegen);
+    bool is_keying();                   // the ISR owns the output's FSELECT
+    void hold();
+    void release();
+    bool is_pending();                  // a change is waiting for step()
+
+    void tick(unsigned long time);      // ISR context
+
+    static void begin();                // start the tick source
+    static void service();              // tick ISR body: step every keyer
+    static bool is_running() { return _running; }
+#else
+    void set_output(WaveGen *) {}
+    bool is_keying() { return false; }
+    void hold() {}
+    void release() {}
+    bool is_pending() { return false; }
+#endif
+
+private:
+    AsyncModulator *_modulator;
+
+#ifdef ENABLE_MODULATION_TICK
+    WaveGen * volatile _output;
+    volatile bool _held;
+    volatile bool _complete;            // message completed in the ISR, not yet reported
+    bool _reported_on;                  // carrier state last reported by step()
+    ModulationKeyer *_next;             // every keyer, walked by service()
+
+    static ModulationKeyer *_first;
+    static bool _running;
+#endif
+};
+
+#endif // __MODULATION_TICK_H__
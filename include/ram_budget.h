@@ -0,0 +1,247 @@
+#ifndef __RAM_BUDGET_H__
+#define __RAM_BUDGET_H__
+
+#include <Arduino.h>
+#include <MD_AD9833.h>
+#include <Encoder.h>
+#include <HT16K33Disp.h>
+#include "display_task.h"
+#include "station_config.h"
+#include "buffers.h"
+#include "wavegen.h"
+#include "wave_gen_pool.h"
+#include "signal_meter.h"
+#include "encoder_handler.h"
+#include "vfo.h"
+#include "vfo_tuner.h"
+#include "contrast.h"
+#include "contrast_handler.h"
+#include "bfo.h"
+#include "bfo_handler.h"
+#include "flashlight.h"
+#include "flashlight_handler.h"
+#include "event_dispatcher.h"
+#include "realization_pool.h"
+#include "station_manager.h"
+#include "loop_profiler.h"
+#include "stack_monitor.h"
+#include "tuning_latency.h"
+#include "input_capture.h"
+#include "sim_station.h"
+#include "sim_numbers.h"
+#include "sim_rtty.h"
+#include "sim_pager.h"
+#include "sim_pager2.h"
+#include "sim_jammer.h"
+#include "sim_test.h"
+
+// Compile-time static RAM model for the active CONFIG_* in station_config.h
+//
+// Sums sizeof() of every global object main.cpp creates for the configuration
+// (stations, shared pointer arrays, realization_stats, wave generators, display
+// and UI objects) plus an allowance for the Arduino core, and fails an AVR
+// build when that projection leaves less than RAM_STACK_HEADROOM bytes of the
+// board's SRAM for the stack and heap.
+//
+// The station counts below mirror the station objects declared in main.cpp;
+// main.cpp static_asserts its realizations[] and realization_stats[] arrays
+// against RAM_MODEL_STATION_COUNT so the two cannot drift apart.
+//
+// The asserts only run on AVR builds - sizeof() on the host is not the AVR
+// layout. The model is a floor, not the linker's figure: string literals
+// outside F() and library statics only show up in RAM_MODEL_CORE_BYTES.
+
+// ========================================
+// STATION COUNTS PER CONFIGURATION
+// ========================================
+#if defined(CONFIG_TEN_CW)
+    #define RAM_MODEL_CW_STATIONS       10
+    #define RAM_MODEL_NUMBERS_STATIONS  5
+    #define RAM_MODEL_RTTY_STATIONS     4
+    #define RAM_MODEL_PAGER_STATIONS    2
+#elif defined(CONFIG_MIXED_STATIONS)
+    #define RAM_MODEL_CW_STATIONS       1
+    #define RAM_MODEL_PAGER2_STATIONS   1
+#elif defined(CONFIG_CW_CLUSTER) || defined(CONFIG_FOUR_CW)
+    #define RAM_MODEL_CW_STATIONS       4
+#elif defined(CONFIG_FIVE_CW) || defined(CONFIG_FIVE_CW_RESOURCE_TEST)
+    #define RAM_MODEL_CW_STATIONS       5
+#elif defined(CONFIG_FILE_PILE_UP)
+    #define RAM_MODEL_CW_STATIONS       3
+#elif defined(CONFIG_FOUR_NUMBERS)
+    #define RAM_MODEL_NUMBERS_STATIONS  4
+#elif defined(CONFIG_FOUR_PAGER)
+    #define RAM_MODEL_PAGER_STATIONS    4
+#elif defined(CONFIG_FOUR_RTTY)
+    #define RAM_MODEL_RTTY_STATIONS     4
+#elif defined(CONFIG_FOUR_JAMMER)
+    #define RAM_MODEL_JAMMER_STATIONS   4
+#elif defined(CONFIG_MINIMAL_CW)
+    #define RAM_MODEL_CW_STATIONS       1
+#elif defined(CONFIG_DEV_LOW_RAM)
+    #define RAM_MODEL_CW_STATIONS       1
+    #define RAM_MODEL_NUMBERS_STATIONS  1
+    #define RAM_MODEL_TEST_STATIONS     1
+#elif defined(CONFIG_TEST_PERFORMANCE)
+    #define RAM_MODEL_TEST_STATIONS     1
+#elif defined(CONFIG_PAGER2_TEST)
+    #define RAM_MODEL_PAGER_STATIONS    1
+#endif
+
+#ifndef RAM_MODEL_CW_STATIONS
+#define RAM_MODEL_CW_STATIONS 0
+#endif
+#ifndef RAM_MODEL_NUMBERS_STATIONS
+#define RAM_MODEL_NUMBERS_STATIONS 0
+#endif
+#ifndef RAM_MODEL_RTTY_STATIONS
+#define RAM_MODEL_RTTY_STATIONS 0
+#endif
+#ifndef RAM_MODEL_PAGER_STATIONS
+#define RAM_MODEL_PAGER_STATIONS 0
+#endif
+#ifndef RAM_MODEL_PAGER2_STATIONS
+#define RAM_MODEL_PAGER2_STATIONS 0
+#endif
+#ifndef RAM_MODEL_JAMMER_STATIONS
+#define RAM_MODEL_JAMMER_STATIONS 0
+#endif
+#ifndef RAM_MODEL_TEST_STATIONS
+#define RAM_MODEL_TEST_STATIONS 0
+#endif
+
+// Configs that also keep a separate SimTransmitter *station_pool[] in main.cpp
+#if defined(CONFIG_TEN_CW) || defined(CONFIG_FIVE_CW_RESOURCE_TEST) || defined(CONFIG_DEV_LOW_RAM) || \
+    defined(CONFIG_FILE_PILE_UP) || defined(CONFIG_TEST_PERFORMANCE) || defined(CONFIG_PAGER2_TEST)
+    #define RAM_MODEL_STATION_POOL_ARRAY 1
+#else
+    #define RAM_MODEL_STATION_POOL_ARRAY 0
+#endif
+
+#define RAM_MODEL_WAVEGENS 4
+
+// ========================================
+// PER-BOARD BUDGET
+// ========================================
+// Total SRAM; override with -DRAM_BUDGET_TOTAL=... for other boards
+#ifndef RAM_BUDGET_TOTAL
+    #if defined(__AVR_ATmega4809__)
+        #define RAM_BUDGET_TOTAL 6144      // Nano Every
+    #elif defined(__AVR_ATmega328P__)
+        #define RAM_BUDGET_TOTAL 2048      // Nano
+    #else
+        #define RAM_BUDGET_TOTAL 0         // unknown board: model only, no assert
+    #endif
+#endif
+
+// Arduino core and library statics not visible to sizeof() here: Serial
+// ring buffers, Wire/TWI buffers (larger on megaAVR), NeoPixel heap buffer,
+// millis() state, and .data string literals
+#ifndef RAM_MODEL_CORE_BYTES
+    #if defined(__AVR_ATmega4809__)
+        #define RAM_MODEL_CORE_BYTES 560
+    #else
+        #define RAM_MODEL_CORE_BYTES 420
+    #endif
+#endif
+
+// Stack and heap reserved below the projection. The ATmega328 build was seen
+// corrupting memory with 487 bytes free (see KNOWN_ISSUES.md), so the reserve
+// is set above that.
+#ifndef RAM_STACK_HEADROOM
+#define RAM_STACK_HEADROOM 512
+#endif
+
+// ========================================
+// MODEL
+// ========================================
+constexpr size_t RAM_MODEL_STATION_COUNT =
+    RAM_MODEL_CW_STATIONS + RAM_MODEL_NUMBERS_STATIONS + RAM_MODEL_RTTY_STATIONS +
+    RAM_MODEL_PAGER_STATIONS + RAM_MODEL_PAGER2_STATIONS + RAM_MODEL_JAMMER_STATIONS +
+    RAM_MODEL_TEST_STATIONS;
+
+// Falls back to 4 like main.cpp's default realization_stats[]
+constexpr size_t RAM_MODEL_STATS_COUNT =
+    (RAM_MODEL_STATION_COUNT == 4 || RAM_MODEL_STATION_COUNT == 0) ? 4 : RAM_MODEL_STATION_COUNT;
+
+constexpr size_t RAM_MODEL_STATIONS =
+    RAM_MODEL_CW_STATIONS * sizeof(SimStation) +
+    RAM_MODEL_NUMBERS_STATIONS * sizeof(SimNumbers) +
+    RAM_MODEL_RTTY_STATIONS * sizeof(SimRTTY) +
+    RAM_MODEL_PAGER_STATIONS * sizeof(SimPager) +
+    RAM_MODEL_PAGER2_STATIONS * sizeof(SimPager2) +
+    RAM_MODEL_JAMMER_STATIONS * sizeof(SimJammer) +
+    RAM_MODEL_TEST_STATIONS * sizeof(SimTest);
+
+// realizations[], optional station_pool[] and realization_stats[]
+constexpr size_t RAM_MODEL_STATION_ARRAYS =
+    RAM_MODEL_STATION_COUNT * sizeof(Realization *) +
+    RAM_MODEL_STATION_POOL_ARRAY * RAM_MODEL_STATION_COUNT * sizeof(SimTransmitter *) +
+    RAM_MODEL_STATS_COUNT * sizeof(bool);
+
+// AD1-4, wavegen1-4, wavegens[], realizer_stats[] and the pool
+constexpr size_t RAM_MODEL_WAVEGEN =
+    RAM_MODEL_WAVEGENS * (sizeof(MD_AD9833) + sizeof(WaveGen) + sizeof(WaveGen *) + sizeof(bool)) +
+    sizeof(WaveGenPool);
+
+// The HT16K33 display object, its display task and the shared text buffers
+// they are fed from, and the TWI transmit queue when the display uses it
+#ifdef HT16K33Twi_QUEUED
+constexpr size_t RAM_MODEL_DISPLAY_TWI = HT16K33Twi_QUEUE_SIZE + 5 * sizeof(byte) + sizeof(unsigned int);
+#else
+constexpr size_t RAM_MODEL_DISPLAY_TWI = 0;
+#endif
+constexpr size_t RAM_MODEL_DISPLAY =
+    sizeof(HT16K33Disp) + sizeof(DisplayTask) + FSTRING_BUFFER + sizeof(display_text_buffer) +
+    RAM_MODEL_DISPLAY_TWI;
+
+// Encoder input: the Encoder objects the handlers allocate, or the capture
+// ring and channels that replace them
+#ifdef ENABLE_INPUT_CAPTURE
+constexpr size_t RAM_MODEL_ENCODER_INPUT = InputCapture::STATIC_BYTES;
+#else
+constexpr size_t RAM_MODEL_ENCODER_INPUT = 2 * sizeof(Encoder);
+#endif
+
+// Encoders, meter, VFOs/options, their handlers and dispatchers
+constexpr size_t RAM_MODEL_UI =
+    2 * sizeof(EncoderHandler) + RAM_MODEL_ENCODER_INPUT + sizeof(SignalMeter) +
+    3 * sizeof(VFO) + sizeof(Contrast) + sizeof(BFO) + sizeof(Flashlight) +
+    3 * sizeof(VFO_Tuner) + sizeof(ContrastHandler) + sizeof(BFOHandler) + sizeof(FlashlightHandler) +
+    6 * sizeof(ModeHandler *) + 2 * sizeof(EventDispatcher) + sizeof(EventDispatcher *);
+
+constexpr size_t RAM_MODEL_MANAGERS =
+    sizeof(StationManager) + sizeof(RealizationPool);
+
+#ifdef ENABLE_LOOP_PROFILER
+constexpr size_t RAM_MODEL_PROFILER = sizeof(LoopProfiler);
+#else
+constexpr size_t RAM_MODEL_PROFILER = 0;
+#endif
+#ifdef ENABLE_STACK_MONITOR
+constexpr size_t RAM_MODEL_STACK_MONITOR = sizeof(StackMonitor);
+#else
+constexpr size_t RAM_MODEL_STACK_MONITOR = 0;
+#endif
+#ifdef ENABLE_TUNING_LATENCY
+constexpr size_t RAM_MODEL_TUNING_LATENCY = sizeof(TuningLatency);
+#else
+constexpr size_t RAM_MODEL_TUNING_LATENCY = 0;
+#endif
+constexpr size_t RAM_MODEL_DIAGNOSTICS = RAM_MODEL_PROFILER + RAM_MODEL_STACK_MONITOR + RAM_MODEL_TUNING_LATENCY;
+
+constexpr size_t RAM_MODEL_STATIC =
+    RAM_MODEL_STATIONS + RAM_MODEL_STATION_ARRAYS + RAM_MODEL_WAVEGEN +
+    RAM_MODEL_DISPLAY + RAM_MODEL_UI + RAM_MODEL_MANAGERS + RAM_MODEL_DIAGNOSTICS +
+    RAM_MODEL_CORE_BYTES;
+
+// ========================================
+// BUDGET CHECK
+// ========================================
+#if defined(__AVR__) && RAM_BUDGET_TOTAL > 0
+static_assert(RAM_MODEL_STATIC + RAM_STACK_HEADROOM <= RAM_BUDGET_TOTAL,
+              "Projected static RAM for this CONFIG_* leaves less than RAM_STACK_HEADROOM for the stack - "
+              "choose a smaller configuration in station_config.h or build for the Nano Every");
+#endif
+
+#endif // __RAM_BUDGET_H__
@@ -7,6 +7,9 @@
 // handles realization using a realizer
 // 
 
+// get_next_event_time() result when nothing is scheduled
+#define NO_PENDING_EVENT 0xFFFFFFFFUL
+
 class Mode;
 
 class Realization
@@ -19,6 +22,18 @@ public:
     virtual bool begin(unsigned long time);
     virtual bool step(unsigned long time);
     virtual void end();
+
+    // Earliest time step() has work to do, NO_PENDING_EVENT if none
+    // A time at or before 'time' means the next step() is due immediately
+    virtual unsigned long get_next_event_time(unsigned long time);
+
+    // Time RealizationPool should next call step(); defaults to get_next_event_time()
+    // Overridden where step() also has per-pass work between events
+    virtual unsigned long get_wake_time(unsigned long time);
+
+    // Have RealizationPool step this realization on its next pass and re-read
+    // its wake time - call after changing its state from outside step()
+    void wake() { _wake_time = 0; _wake_pending = true; }
     
     // Update station ID for debugging (used by jammer which sets frequency dynamically)
     void set_station_id(int station_id) { _station_id = station_id; }
@@ -29,6 +44,9 @@ public:
     WaveGenPool *_wave_gen_pool;
     int _realizer;
     int _station_id;
+
+    unsigned long _wake_time;       // cached get_wake_time(), owned by RealizationPool
+    static bool _wake_pending;      // some realization called wake()
 };
 
 #endif
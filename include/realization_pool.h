@@ -7,6 +7,11 @@
 // initialize with an array of realizers
 // tracks whether they are in use
 // can request 1 or more realizers
+//
+// step() only steps realizations whose wake time has come. Each one's
+// get_wake_time() is cached after it steps, along with the earliest of them,
+// so a pass where nothing is due costs one comparison. Realizations changed
+// from outside step() call wake() to be stepped on the next pass.
 
 class RealizationPool
 {
@@ -18,6 +23,9 @@ public:
     bool step(unsigned long time);
     void end();
 
+    // Earliest get_next_event_time() across all realizations
+    unsigned long get_next_event_time(unsigned long time);
+
     void update(Mode *mode);
     void force_sim_transmitter_refresh();  // Force hardware refresh for SimTransmitter objects
     void mark_dirty();  // Mark hardware state as unknown - triggers refresh on next update
@@ -27,6 +35,7 @@ private:
     bool *_statuses;
     int _nrealizations;
     bool _hardware_dirty;  // True when hardware state is unknown and needs refresh
+    unsigned long _next_wake;  // earliest cached wake time
 };
 
 #endif // __REALIZER_POOL_H__
@@ -1,10 +1,8 @@
 #ifndef __SIGNAL_METER_H__
 #define __SIGNAL_METER_H__
 
-#ifndef NATIVE_BUILD
 #include <Arduino.h>
 #include <Adafruit_NeoPixel.h>
-#endif
 
 // Signal Meter - 7 WS2812 LEDs showing signal strength
 // Uses capacitor-like charging/discharging behavior for realistic analog meter response
@@ -15,9 +13,23 @@
 // - update() applies time-based decay (like capacitor discharge through resistor)
 // - Results in smooth, realistic meter response with persistence and decay
 //
+// RENDERING:
+// add_charge() only integrates the pulse; the LEDs are rendered by the next
+// update(), once per loop pass however many stations pulsed. Each NeoPixel
+// show() holds interrupts off for the whole strip, so rendering per pulse
+// stalled the loop once per keyed station.
+//
+// Rendering is also capped at one frame per FRAME_INTERVAL (50 fps), and the
+// strip's pixel buffer doubles as the frame buffer: each pixel is compared
+// before it is set and show() only runs when one actually changed, so a
+// steady meter costs no strip traffic at all. Strength-to-LEDs and contrast
+// scaling come from lookup tables instead of sqrt and multiply/divide.
+// update_panel_led() likewise only writes the lock LED's PWM on a change.
+//
 // USAGE:
 // 1. Call add_charge() whenever tuning events occur (e.g., encoder changes)
-// 2. Call update() regularly in main loop for time-based decay
+// 2. Call update() once per main loop pass for time-based decay and rendering,
+//    and update_panel_led() to drive the white panel lock LED
 // 3. Meter will smoothly charge up during tuning and decay when idle
 //
 // TUNING TIPS:
@@ -48,13 +60,17 @@ public:
     int get_current_strength() const { return _current_strength; }    // Panel LED lock indicator accessor
     int get_panel_led_brightness() const { return _panel_led_accumulator; }
     void clear_panel_led();
+    void update_panel_led();                   // Write the lock LED PWM if it changed
     
     // Flashlight mode control
     void set_flashlight_mode(int brightness);  // Set LEDs to white at specified brightness (0-255)
     void clear_flashlight_mode();              // Return to normal signal meter operation
 
 private:
-    void write_leds();
+    bool write_leds();                          // Returns true if the strip was refreshed
+    bool set_pixel(int index, uint32_t color);  // Returns true if the pixel changed
+    void build_levels();
+    static const unsigned long FRAME_INTERVAL = 20;  // Minimum milliseconds between strip refreshes (50 fps)
     static const int MAX_ACCUMULATOR = 510;     // Maximum accumulator value (2x LED range for resolution)
     // Panel LED lock indicator parameters
     static const int PANEL_LED_MAX_ACCUMULATOR = 255;
@@ -67,17 +83,21 @@ private:
     
     int _accumulator;                           // Current charge accumulator (0 to MAX_ACCUMULATOR)
     int _current_strength;                      // Current display strength (0-255)
+    bool _dirty;                                // Strength changed since the LEDs were last written
     unsigned long _last_decay_time;             // Last time decay was applied
+    unsigned long _last_frame_time;             // Last time the strip was refreshed
+    
+    uint8_t _channel_levels[17];                // Channel brightness by sixteenths lit, at _levels_contrast
+    int _levels_contrast;                       // option_contrast the table was built for (-1 = not built)
     
     int _panel_led_accumulator;                 // Accumulator for panel LED lock indicator (0 to PANEL_LED_MAX_ACCUMULATOR)
+    int _panel_led_pwm;                         // PWM last written to the lock LED (-1 = not written)
     
     bool _flashlight_mode;                      // True when in flashlight mode
     int _flashlight_brightness;                 // Brightness level for flashlight mode (0-255)
 
-#ifndef NATIVE_BUILD
     // Use Adafruit NeoPixel for both platforms
     static Adafruit_NeoPixel* _led_strip;
-#endif
 };
 
 #endif // __SIGNAL_METER_H__
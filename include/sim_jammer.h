@@ -12,6 +12,7 @@ public:
     virtual bool begin(unsigned long time, float fixed_freq);
     virtual bool update(Mode *mode);
     virtual bool step(unsigned long time);
+    virtual unsigned long get_next_event_time(unsigned long time);
     virtual void realize();
     
 private:
@@ -2,6 +2,7 @@
 #define __SIM_NUMBERS_H__
 
 #include "async_morse.h"
+#include "modulation_tick.h"
 #include "sim_transmitter.h"
 
 class SignalMeter; // Forward declaration
@@ -21,6 +22,9 @@ public:
     
     virtual bool update(Mode *mode) override;
     virtual bool step(unsigned long time) override;
+    virtual unsigned long get_next_event_time(unsigned long time) override;
+    virtual unsigned long get_wake_time(unsigned long time) override;
+    virtual void end() override;
 
     void realize();
 
@@ -28,7 +32,9 @@ private:    void generate_next_number_group();
     void generate_interval_signal();
     void generate_ending_sequence();
     void apply_frequency_drift();   // Add slight frequency drift for creepiness
+    void start_group();             // Start sending _group_buffer
       AsyncMorse _morse;
+    ModulationKeyer _keyer;
     char _group_buffer[6];          // Buffer for single 5-digit group + null ("12345")
     int _groups_sent;               // Count of groups sent in current cycle
     int _total_groups_per_cycle;    // Total groups to send per cycle (13 for creepiness)
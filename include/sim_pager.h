@@ -18,6 +18,8 @@ public:
       virtual bool begin(unsigned long time) override;
     virtual bool update(Mode *mode) override;
     virtual bool step(unsigned long time) override;
+    virtual unsigned long get_next_event_time(unsigned long time) override;
+    virtual unsigned long get_wake_time(unsigned long time) override;
       void realize();
       // Debug method to display current tone pair
     void debug_print_tone_pair() const;
@@ -3,10 +3,12 @@
 
 #include "sim_transmitter.h"
 #include "async_rtty.h"
+#include "modulation_tick.h"
 
 class SignalMeter; // Forward declaration
 
 #define MARK_FREQ_SHIFT 170.0
+#define MARK_SHIFT_DHZ ((long)(MARK_FREQ_SHIFT * 10))
 #define RTTY_WAIT_SECONDS 6      // Wait time between message rounds
 #define RTTY_MARK_TONE_SECONDS 3 // Duration of MARK tone between messages and at round start
 
@@ -17,6 +19,9 @@ public:
     
     virtual bool update(Mode *mode) override;
     virtual bool step(unsigned long time) override;
+    virtual unsigned long get_next_event_time(unsigned long time) override;
+    virtual unsigned long get_wake_time(unsigned long time) override;
+    virtual void end() override;
     
     void realize();
     
@@ -24,7 +29,10 @@ public:
     bool is_in_wait_delay() const { return _in_wait_delay; }
     
 private:
+    void start_message();           // Start sending rtty_message
+
     AsyncRTTY _rtty;
+    ModulationKeyer _keyer;
     int _phase;
     SignalMeter *_signal_meter;     // Pointer to signal meter for charge pulses    // Message cycling state
     bool _in_wait_delay;            // True when waiting between messages
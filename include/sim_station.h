@@ -2,6 +2,7 @@
 #define __SIM_STATION_H__
 
 #include "async_morse.h"
+#include "modulation_tick.h"
 #include "sim_transmitter.h"
 
 class SignalMeter; // Forward declaration
@@ -23,6 +24,9 @@ public:
     
     virtual bool update(Mode *mode) override;
     virtual bool step(unsigned long time) override;
+    virtual unsigned long get_next_event_time(unsigned long time) override;
+    virtual unsigned long get_wake_time(unsigned long time) override;
+    virtual void end() override;
 
     void realize();
     void apply_wpm_drift();         // Add slight WPM drift for realism
@@ -33,6 +37,7 @@ public:
 
 private:
     AsyncMorse _morse;
+    ModulationKeyer _keyer;
     bool _changed;
     SignalMeter *_signal_meter;
     char _generated_message[MESSAGE_BUFFER];     // Generated CQ message with random callsign
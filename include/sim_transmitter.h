@@ -19,6 +19,10 @@ enum StationState {
 #define MIN_AUDIBLE_FREQ 150.0
 #define SILENT_FREQ 0.1
 
+// The same limits in tenths of a hertz, for the integer audio frequency
+#define MAX_AUDIBLE_DHZ ((long)(MAX_AUDIBLE_FREQ * 10))
+#define MIN_AUDIBLE_DHZ ((long)(MIN_AUDIBLE_FREQ * 10))
+
 // BFO (Beat Frequency Oscillator) offset for comfortable audio tuning
 // This shifts the audio frequency without affecting signal meter calculations
 // Now dynamically adjustable via option_bfo_offset (0-2000 Hz)
@@ -61,12 +65,21 @@ protected:    // Common utility methods
     bool check_frequency_bounds();  // Returns true if frequency is in audible range
     bool common_begin(unsigned long time, float fixed_freq);  // Common initialization logic
     void common_frequency_update(Mode *mode);  // Common frequency calculation (mode must be VFO)
-    void force_frequency_update();  // Immediately update wave generator after _fixed_freq changes// Common member variables
+    void force_frequency_update();  // Immediately update wave generator after _fixed_freq changes
+    void set_fixed_frequency(float fixed_freq);  // Sets _fixed_freq and _fixed_dhz together
+
+    // Audio frequency as a float, for stations that add float tone offsets;
+    // stations on the plain audio frequency pass tuning words instead
+    float audio_frequency() const { return _frequency_dhz * 0.1f; }
+
+    // Common member variables
     float _fixed_freq;  // Target frequency for this station
+    unsigned long _fixed_dhz;   // The same in tenths of a hertz
     bool _enabled;      // True when frequency is in audible range
-    float _frequency;   // Current frequency difference from VFO
+    long _frequency_dhz;        // Current frequency difference from VFO plus BFO, tenths of a hertz
     float _vfo_freq;    // Current VFO frequency (for signal meter charge calculation)
                         // NOTE: Required by StationManager when using shared Realization arrays
+    unsigned long _vfo_dhz;     // The same in tenths of a hertz, for the audio frequency
     bool _active;       // True when transmitter should be active
     
     // Dynamic station management state
@@ -0,0 +1,81 @@
+#ifndef __STACK_MONITOR_H__
+#define __STACK_MONITOR_H__
+
+#include <Arduino.h>
+#include <HT16K33Disp.h>
+#include "station_config.h"
+#include "loop_profiler.h"
+
+// Stack high-water monitor - stack painting with low duty cycle scanning
+//
+// paint() fills the free RAM between the end of the heap and the stack
+// pointer with a canary byte. The stack grows down into that area; the lowest
+// address it has ever overwritten is the high-water mark, and the distance from
+// the heap end up to it is the least free RAM ever observed.
+//
+// Two checks keep the mark current without scanning the whole area every pass:
+// - check(phase), called at each loop phase boundary, looks only at the bytes
+//   just below the current mark, so a new low is charged to the phase that
+//   just ran (interrupts land in whichever phase they interrupted)
+// - step(), once per pass, walks STACK_MONITOR_SCAN_BYTES of the painted area
+//   from the heap end up, catching lows the probe missed because the stack
+//   happened to leave a canary-valued byte at the old mark
+//
+// USAGE:
+// 1. Uncomment ENABLE_STACK_MONITOR in station_config.h (~16 bytes RAM)
+// 2. Send 's' over Serial for the report, 'd' to toggle showing it on the display
+//
+// AVR only; on host builds paint() leaves the monitor inactive.
+
+#define STACK_CANARY 0xC5
+
+#define STACK_MONITOR_PROBE_BYTES 4     // bytes below the mark examined by check()
+#define STACK_MONITOR_SCAN_BYTES 32     // painted bytes examined per step()
+#define STACK_MONITOR_PAINT_MARGIN 32   // left unpainted below SP for paint()'s own frame
+#define STACK_MONITOR_DISPLAY_MS 500    // diagnostic display refresh
+
+#define STACK_PHASE_SETUP 0xFE          // low set before the main loop started
+#define STACK_PHASE_SCAN  0xFF          // low found by the background scan
+
+class StackMonitor
+{
+public:
+    StackMonitor();
+
+    void paint();
+    void check(byte phase);
+    void step(unsigned long time, HT16K33Disp *display);
+
+    // Serial interface: 's' prints the report, 'd' toggles the display mode;
+    // returns false for commands it does not handle
+    bool handle_command(char command);
+    void print_report();
+
+    bool is_active() const { return _mark != 0; }
+    unsigned int get_min_free() const;
+    byte get_low_phase() const { return _low_phase; }
+    bool is_showing() const { return _showing; }
+
+private:
+    void new_low(uint8_t *mark, byte phase);
+    static uint8_t *heap_end();
+    static void print_phase_name(byte phase);
+
+    uint8_t *_mark;             // lowest stack byte ever overwritten
+    uint8_t *_scan;             // background scan position
+    byte _low_phase;
+    unsigned int _lows;         // times a new low was set
+    unsigned int _painted;      // bytes painted at boot
+    bool _showing;
+    unsigned long _next_display;
+};
+
+#ifdef ENABLE_STACK_MONITOR
+extern StackMonitor stack_monitor;
+
+#define STACK_CHECK(phase)  stack_monitor.check(phase)
+#else
+#define STACK_CHECK(phase)
+#endif
+
+#endif // __STACK_MONITOR_H__
@@ -46,6 +46,43 @@
 // #define DEBUG_WAVE_GEN_POOL  // Uncomment to enable resource debug output
 // #define DEBUG_STATION_RESOURCES  // Uncomment to enable station resource debug output
 
+// Loop Profiler - micros() timing of each main loop phase with log2 histograms
+// Send 'p' over Serial to print min/p99/max per phase, 'r' to reset
+// Costs ~360 bytes RAM - disable for production
+// #define ENABLE_LOOP_PROFILER  // Uncomment to enable loop profiling
+
+// Stack Monitor - paints free RAM at boot and tracks the stack high-water mark
+// and the loop phase that set it. Send 's' over Serial for the report, 'd' to
+// toggle showing "S<free> P<phase>" on the display. Costs ~16 bytes RAM
+// #define ENABLE_STACK_MONITOR  // Uncomment to enable stack monitoring
+
+// Tuning Latency - time from an encoder detent to the last AD9833 frequency
+// write it causes. Send 'l' over Serial for mean/p95/max, 'x' to reset
+// Costs ~90 bytes RAM - disable for production
+// #define ENABLE_TUNING_LATENCY  // Uncomment to enable latency measurement
+
+// Modulation Tick - Morse and RTTY element timing stepped from a 1 kHz timer
+// interrupt (Timer2 on the Nano, TCB2 on the Nano Every) that keys the AD9833
+// directly, so keying no longer waits for slow loop phases (display, LEDs)
+// Costs ~9 bytes RAM per Morse/RTTY station
+// #define ENABLE_MODULATION_TICK  // Uncomment to key from the timer interrupt
+
+// Input Capture - include/input_capture.h decodes both encoders and their buttons
+// in pin change interrupts into a ring of timestamped events, so turns and presses
+// are never lost or late while the loop is busy (display scrolls, LED updates)
+// Costs ~120 bytes RAM, less the two Encoder objects it replaces
+// #define ENABLE_INPUT_CAPTURE  // Uncomment to capture the encoders in interrupts
+
+// Async TWI - HT16K33 display frames are queued and clocked out by the TWI
+// interrupt at 400 kHz instead of blocking the loop in Wire (~1 ms per frame).
+// The display library is compiled on its own, so this one is a build flag:
+// uncomment "build_flags = -DENABLE_ASYNC_TWI" under the board's env in
+// platformio.ini. Costs ~40 bytes RAM, less Wire's buffers it replaces
+
+// RAM Budget - include/ram_budget.h models static RAM for the active configuration
+// and fails AVR builds that leave less than RAM_STACK_HEADROOM (512 bytes) for
+// the stack; override with -DRAM_STACK_HEADROOM=... in platformio.ini build_flags
+
 // RTTY Memory Optimization
 // For minimal Flash usage, you can disable real Baudot encoding and just generate random bits
 // The RTTY simulation will sound authentic but won't transmit actual text
@@ -33,6 +33,21 @@
 #define PIPELINE_AUDIBLE_RANGE 5000      // Range where stations become audible
 #define PIPELINE_REALLOC_THRESHOLD 3000  // Reallocate when VFO moves 3 kHz
 #define PIPELINE_TUNE_DETECT_THRESHOLD 100  // Minimum Hz change to detect tuning activity
+#define PIPELINE_SETTLE_MS 5000          // Pause the pipeline this long after the last tuning - longer to allow listening
+
+// Relocated station placement (tuned by ear) - overridable from build flags for A/B runs
+#ifndef PIPELINE_PLACE_UP_OFFSET
+#define PIPELINE_PLACE_UP_OFFSET 2000      // Tuning up: first station this far above VFO
+#endif
+#ifndef PIPELINE_PLACE_UP_STEP
+#define PIPELINE_PLACE_UP_STEP 1000        // ...and each further station this much higher
+#endif
+#ifndef PIPELINE_PLACE_DOWN_OFFSET
+#define PIPELINE_PLACE_DOWN_OFFSET 5700    // Tuning down: first station this far below VFO
+#endif
+#ifndef PIPELINE_PLACE_DOWN_STEP
+#define PIPELINE_PLACE_DOWN_STEP 500       // ...and each further station this much lower
+#endif
 
 class StationManager {
 public:
@@ -54,6 +69,10 @@ public:
     int getTuningDirection() const { return tuning_direction; }
     uint32_t getPipelineCenterFreq() const { return pipeline_center_freq; }
     
+    // Scheduling and statistics
+    unsigned long getNextEventTime() const;  // Next time-based pipeline change, NO_PENDING_EVENT if none
+    unsigned long getRelocationCount() const { return relocation_count; }  // Stations moved by reallocateStations()
+    
 private:
     SimTransmitter** stations;
     int actual_station_count;
@@ -65,6 +84,7 @@ private:
     uint32_t pipeline_center_freq;
     int tuning_direction; // -1 = down, 0 = stopped, 1 = up
     unsigned long last_tuning_time; // Last time VFO frequency changed significantly
+    unsigned long relocation_count; // Total stations moved since power-up
     
     // Private methods
     void activateStation(int idx, uint32_t freq);
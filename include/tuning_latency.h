@@ -0,0 +1,75 @@
+#ifndef __TUNING_LATENCY_H__
+#define __TUNING_LATENCY_H__
+
+#include <Arduino.h>
+#include "station_config.h"
+
+// Encoder-to-audio latency - time from a tuning detent to the last AD9833
+// frequency write it causes
+//
+// EncoderHandler stamps the first detent of each batch with micros(). When the
+// main loop dispatches that batch it opens a trace with the stamp; a
+// WaveGen::flush() that sends frequency data to a chip while the trace is
+// open moves the trace's end time, and closing the trace after the flush
+// that follows update_realization() records stamp..last write. Batches that write nothing (settings app, no
+// station in range) are only counted.
+//
+// The stamp is taken when EncoderHandler::step() sees the detent, so time the
+// detent waited for the loop to come round is not included - unless
+// ENABLE_INPUT_CAPTURE is on, when it is the pin change interrupt's time.
+//
+// USAGE:
+// 1. Uncomment ENABLE_TUNING_LATENCY in station_config.h (~90 bytes RAM)
+// 2. Send 'l' over Serial to print mean/p95/max, 'x' to reset
+
+#define TUNING_LATENCY_BUCKETS 32
+#define TUNING_LATENCY_BUCKET_US 256    // linear buckets up to 8.2 ms, longer ones land in the last
+
+class TuningLatency
+{
+public:
+    TuningLatency();
+
+    void begin(unsigned long detent_time);
+    void mark_write();
+    void end();
+
+    void record(unsigned long latency);
+    void reset();
+
+    // Serial interface: 'l' prints the statistics, 'x' resets them;
+    // returns false for commands it does not handle
+    bool handle_command(char command);
+    void print_report();
+
+    unsigned long get_count() const { return _count; }
+    unsigned long get_mean() const { return _count ? _total / _count : 0; }
+    unsigned long get_max() const { return _max; }
+    unsigned long get_percentile(byte percent) const;  // upper bound of the bucket holding the percentile
+
+private:
+    uint16_t _buckets[TUNING_LATENCY_BUCKETS];
+    unsigned long _count;
+    unsigned long _silent;      // batches that produced no frequency write
+    unsigned long _total;
+    unsigned long _max;
+
+    bool _open;
+    unsigned long _detent_time;
+    unsigned long _last_write;
+    bool _written;
+};
+
+#ifdef ENABLE_TUNING_LATENCY
+extern TuningLatency tuning_latency;
+
+#define TUNING_LATENCY_BEGIN(detent_time)  tuning_latency.begin(detent_time)
+#define TUNING_LATENCY_WRITE()             tuning_latency.mark_write()
+#define TUNING_LATENCY_END()               tuning_latency.end()
+#else
+#define TUNING_LATENCY_BEGIN(detent_time)  do {} while (0)
+#define TUNING_LATENCY_WRITE()             do {} while (0)
+#define TUNING_LATENCY_END()               do {} while (0)
+#endif
+
+#endif // __TUNING_LATENCY_H__
@@ -1,10 +1,25 @@
 #ifndef __VFO_TUNER_H__
 #define __VFO_TUNER_H__
 
+#include <Arduino.h>
 #include <HT16K33Disp.h>
 #include "mode.h"
 #include "mode_handler.h"
 
+// Velocity tuning acceleration
+//
+// event_sink() gets the signed count of detents turned since the last loop
+// pass. The time per detent since the previous batch picks a multiplier for
+// the VFO's _step: a slow turn keeps the step (10 Hz), a brisk spin moves
+// 100 Hz per detent and a fast one 1 kHz, so crossing the band takes a few
+// turns instead of hundreds. The first batch after a pause always uses the
+// plain step. Host tools that script trajectories in detents of _step turn
+// it off with set_acceleration(false).
+#define TUNING_ACCEL_FAST_MS        8     // at most this many ms per detent: fast spin
+#define TUNING_ACCEL_FAST_FACTOR    100
+#define TUNING_ACCEL_MEDIUM_MS      25    // brisk turn
+#define TUNING_ACCEL_MEDIUM_FACTOR  10
+
 class VFO_Tuner : public ModeHandler
 {
 public:
@@ -29,7 +44,13 @@ public:
 
     void step_down(unsigned long steps);
 
+    void set_acceleration(bool accelerate) { _accelerate = accelerate; }
+
 private:
+    unsigned long accel_factor(int detents);
+
+    bool _accelerate;
+    unsigned long _last_tune_time;          // millis() of the previous tuning batch
 };
 
 #endif // __VFO_TUNER_H__
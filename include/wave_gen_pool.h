@@ -21,14 +21,19 @@ public:
 
     WaveGen * access_realizer(int nrealizer);
 
+    // write what the stations staged on the generators, once per loop pass
+    void flush() { WaveGen::flush(_realizers, _nrealizers); }
+
     // Get resource statistics for debugging
     int get_available_count();
     int get_total_count() { return _nrealizers; }
+    unsigned long get_failed_count() const { return _failed_requests; }  // get_realizer() calls that found none free
 
 private:
     WaveGen **_realizers;
     bool *_statuses;
     int _nrealizers;
+    unsigned long _failed_requests;
 
 };
 
@@ -2,20 +2,60 @@
 #define __WAVEGEN_H__
 
 #include <MD_AD9833.h>
+#include "station_config.h"
+
+#define WAVEGEN_BROADCAST_MAX 4     // chips per broadcast write, all four FluxTune AD9833s
+
+// Stations stage the state they want: set_frequency() and
+// set_active_frequency() only record it, and flush() - once per main loop
+// pass, from WaveGenPool::flush() - writes what changed since the last
+// flush. However many times a station repeats or revises a setting within
+// a pass, the chip sees the final one, once.
 
 class WaveGen
 {
 public:
     WaveGen(MD_AD9833 * sig_gen);
 
+    // Changes are detected on the 28-bit tuning word, so callers that have
+    // the frequency as an integer skip the float conversion entirely
     void set_frequency(float frequency, bool main=true);
+    void set_frequency_word(uint32_t word, bool main=true);
+    static uint32_t tuning_word(float frequency);
+    static uint32_t tuning_word_dhz(long frequency_dhz);    // tenths of a hertz
     void set_active_frequency(bool main);
-    void force_refresh();  // Force hardware update regardless of cached state
+    void force_refresh();  // Force hardware update regardless of cached state, now
+
+    // Both channels of several generators to the silent frequency; flush()
+    // writes the same word to several chips as one AD9833 broadcast
+    static void silence(WaveGen *wavegens[], byte count);
+
+    // Write the staged changes of these generators to the chips
+    static void flush(WaveGen *wavegens[], byte count);
+
+#ifdef ENABLE_MODULATION_TICK
+    // FSELECT flip from the modulation tick ISR; deferred to the main loop
+    // while a main loop write holds the shared AD9833 bus
+    void key(bool main);
+#endif
 
     MD_AD9833 * _sig_gen;
-    float _frequency_main;
-    float _frequency_alt;
-    bool _main;
+    uint32_t _word_main;
+    uint32_t _word_alt;
+    volatile bool _main;                // also written by key() in the ISR
+    byte _dirty;                        // DIRTY_ bits, staged since the last flush()
+
+#ifdef ENABLE_MODULATION_TICK
+private:
+    static void acquire_bus();
+    static void release_bus();
+
+    volatile int8_t _pending_key;       // -1 none, else the channel key() could not select
+    WaveGen *_next;                     // every WaveGen, for release_bus()
+
+    static volatile bool _bus_busy;
+    static WaveGen *_first;
+#endif
 };
 
 #endif
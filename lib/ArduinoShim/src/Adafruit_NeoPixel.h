@@ -0,0 +1,47 @@
+#ifndef __ADAFRUIT_NEOPIXEL_SHIM_H__
+#define __ADAFRUIT_NEOPIXEL_SHIM_H__
+
+#include <Arduino.h>
+
+// Host stand-in for adafruit/Adafruit NeoPixel
+// Keeps the pixel buffer and counts show() calls (each one is a ~30us strip refresh on hardware)
+
+#define NEO_GRB    0x52
+#define NEO_RGB    0x06
+#define NEO_KHZ800 0x0000
+
+#define NATIVE_NEOPIXEL_MAX_PIXELS 16
+
+class Adafruit_NeoPixel
+{
+public:
+    Adafruit_NeoPixel(uint16_t n, int16_t pin = 6, uint16_t type = NEO_GRB + NEO_KHZ800)
+        : _count(n > NATIVE_NEOPIXEL_MAX_PIXELS ? NATIVE_NEOPIXEL_MAX_PIXELS : n), _show_count(0) {
+        (void)pin; (void)type;
+        clear();
+    }
+
+    void begin() {}
+    void show() { _show_count++; }
+    void clear() { memset(_pixels, 0, sizeof(_pixels)); }
+    void setBrightness(uint8_t brightness) { (void)brightness; }
+
+    void setPixelColor(uint16_t n, uint32_t c) { if(n < _count) _pixels[n] = c; }
+    void setPixelColor(uint16_t n, uint8_t r, uint8_t g, uint8_t b) { setPixelColor(n, Color(r, g, b)); }
+    uint32_t getPixelColor(uint16_t n) const { return n < _count ? _pixels[n] : 0; }
+    uint16_t numPixels() const { return _count; }
+
+    static uint32_t Color(uint8_t r, uint8_t g, uint8_t b) {
+        return ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
+    }
+
+    // Host statistics
+    unsigned long get_show_count() const { return _show_count; }
+
+private:
+    uint16_t _count;
+    uint32_t _pixels[NATIVE_NEOPIXEL_MAX_PIXELS];
+    unsigned long _show_count;
+};
+
+#endif // __ADAFRUIT_NEOPIXEL_SHIM_H__
@@ -0,0 +1,158 @@
+#ifndef __ARDUINO_SHIM_H__
+#define __ARDUINO_SHIM_H__
+
+// ============================================================================
+// ARDUINO CORE SHIM FOR [env:native]
+// ============================================================================
+// Just enough of the Arduino/AVR core for the FluxTune station stack to build
+// and run on a Linux host. Only compiled for the native platform (see
+// library.json), so it never shadows the real core on the AVR targets.
+//
+// Time comes from a virtual clock that only moves when the host program moves
+// it (see native_host.h) or when firmware code calls delay(). This keeps host
+// runs deterministic and lets a simulator jump straight to the next event.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT        0x0
+#define OUTPUT       0x1
+#define INPUT_PULLUP 0x2
+
+#define LED_BUILTIN 13
+
+// Analog pins numbered as on the Nano (A0 = digital 14)
+#define A0 14
+#define A1 15
+#define A2 16
+#define A3 17
+#define A4 18
+#define A5 19
+#define A6 20
+#define A7 21
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+// ========================================
+// PROGRAM MEMORY
+// ========================================
+// Flash and RAM share one address space on the host
+#define PROGMEM
+#define PSTR(s) (s)
+
+class __FlashStringHelper;
+#define F(s) (reinterpret_cast<const __FlashStringHelper *>(s))
+
+#define pgm_read_byte(addr)  (*(const uint8_t *)(addr))
+#define pgm_read_word(addr)  (native_pgm_read_word((const void *)(addr)))
+#define pgm_read_dword(addr) (native_pgm_read_dword((const void *)(addr)))
+#define strcpy_P(dest, src)  strcpy((dest), (src))
+#define strlen_P(s)          strlen(s)
+
+inline uint16_t native_pgm_read_word(const void *addr){
+    uint16_t value;
+    memcpy(&value, addr, sizeof(value));
+    return value;
+}
+
+inline uint32_t native_pgm_read_dword(const void *addr){
+    uint32_t value;
+    memcpy(&value, addr, sizeof(value));
+    return value;
+}
+
+// ========================================
+// TIMING
+// ========================================
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+// ========================================
+// RANDOM NUMBERS
+// ========================================
+// Overloads sit alongside libc's random(void); randomSeed() makes runs repeatable
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+
+// ========================================
+// DIGITAL / ANALOG I/O
+// ========================================
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+void analogWrite(uint8_t pin, int value);
+
+// ========================================
+// INTERRUPTS
+// ========================================
+inline void interrupts() {}
+inline void noInterrupts() {}
+
+// Every pin has an external interrupt, numbered as the pin; native_set_pin()
+// and native_turn_encoder() run the attached isr on a matching level change
+#define CHANGE  1
+#define FALLING 2
+#define RISING  3
+#define NOT_AN_INTERRUPT -1
+#define digitalPinToInterrupt(p) ((p) < NATIVE_NUM_PINS ? (int)(p) : NOT_AN_INTERRUPT)
+
+void attachInterrupt(int interrupt, void (*isr)(), int mode);
+void detachInterrupt(int interrupt);
+
+// ========================================
+// AVR LIBC EXTRAS
+// ========================================
+char *itoa(int value, char *buffer, int radix);
+char *ltoa(long value, char *buffer, int radix);
+
+// ========================================
+// SERIAL
+// ========================================
+class HardwareSerial
+{
+public:
+    void begin(unsigned long baud) { (void)baud; }
+    void end() {}
+    int available();
+    int read();
+    void flush();
+    size_t write(uint8_t c);
+
+    size_t print(const char *s);
+    size_t print(const __FlashStringHelper *s);
+    size_t print(char c);
+    size_t print(unsigned char n, int base = DEC);
+    size_t print(int n, int base = DEC);
+    size_t print(unsigned int n, int base = DEC);
+    size_t print(long n, int base = DEC);
+    size_t print(unsigned long n, int base = DEC);
+    size_t print(double n, int digits = 2);
+
+    size_t println();
+    template<typename T> size_t println(T value) { size_t n = print(value); return n + println(); }
+    template<typename T> size_t println(T value, int format) { size_t n = print(value, format); return n + println(); }
+
+    operator bool() const { return true; }
+};
+
+extern HardwareSerial Serial;
+
+#include "native_host.h"
+
+#endif // __ARDUINO_SHIM_H__
@@ -0,0 +1,41 @@
+#ifndef __EEPROM_SHIM_H__
+#define __EEPROM_SHIM_H__
+
+#include <Arduino.h>
+
+// Host stand-in for the EEPROM library, backed by RAM and erased to 0xFF like a new part
+// Sized for the ATmega328 (1 KB) so the EEPROM table addresses also fit
+
+#define NATIVE_EEPROM_SIZE 1024
+
+class EEPROMClass
+{
+public:
+    EEPROMClass() { memset(_data, 0xFF, sizeof(_data)); }
+
+    uint8_t read(int address) const { return in_range(address) ? _data[address] : 0xFF; }
+    void write(int address, uint8_t value) { if(in_range(address)) _data[address] = value; }
+    void update(int address, uint8_t value) { write(address, value); }
+    uint16_t length() const { return NATIVE_EEPROM_SIZE; }
+
+    template<typename T> T &get(int address, T &t) const {
+        if(address >= 0 && address + (int)sizeof(T) <= NATIVE_EEPROM_SIZE)
+            memcpy(&t, _data + address, sizeof(T));
+        return t;
+    }
+
+    template<typename T> const T &put(int address, const T &t) {
+        if(address >= 0 && address + (int)sizeof(T) <= NATIVE_EEPROM_SIZE)
+            memcpy(_data + address, &t, sizeof(T));
+        return t;
+    }
+
+private:
+    static bool in_range(int address) { return address >= 0 && address < NATIVE_EEPROM_SIZE; }
+
+    uint8_t _data[NATIVE_EEPROM_SIZE];
+};
+
+extern EEPROMClass EEPROM;
+
+#endif // __EEPROM_SHIM_H__
@@ -0,0 +1,23 @@
+#ifndef __ENCODER_SHIM_H__
+#define __ENCODER_SHIM_H__
+
+#include <Arduino.h>
+
+// Host stand-in for paulstoffregen/Encoder
+// Position is held by the shim per clock pin and moved with native_turn_encoder()
+
+class Encoder
+{
+public:
+    Encoder(uint8_t pin1, uint8_t pin2) : _pin1(pin1), _offset(0) { (void)pin2; }
+
+    long read() { return native_get_encoder_position(_pin1) - _offset; }
+    void write(long position) { _offset = native_get_encoder_position(_pin1) - position; }
+    long readAndReset() { long position = read(); write(0); return position; }
+
+private:
+    uint8_t _pin1;
+    long _offset;
+};
+
+#endif // __ENCODER_SHIM_H__
@@ -0,0 +1,40 @@
+#ifndef __WIRE_SHIM_H__
+#define __WIRE_SHIM_H__
+
+#include <Arduino.h>
+
+// Host stand-in for the Wire (TWI/I2C) library
+// Transmissions are accepted and counted so host programs can measure display traffic
+
+class TwoWire
+{
+public:
+    TwoWire();
+
+    void begin() {}
+    void setClock(uint32_t frequency) { (void)frequency; }
+
+    void beginTransmission(uint8_t address);
+    size_t write(uint8_t data);
+    size_t write(const uint8_t *data, size_t quantity);
+    uint8_t endTransmission(bool send_stop = true);
+
+    uint8_t requestFrom(uint8_t address, uint8_t quantity) { (void)address; (void)quantity; return 0; }
+    int available() { return 0; }
+    int read() { return -1; }
+
+    // Host statistics
+    unsigned long get_transmission_count() const { return _transmissions; }
+    unsigned long get_byte_count() const { return _bytes; }
+    void reset_counts() { _transmissions = 0; _bytes = 0; }
+
+private:
+    uint8_t _address;
+    bool _in_transmission;
+    unsigned long _transmissions;   // Completed endTransmission() calls
+    unsigned long _bytes;           // Payload bytes, address byte not included
+};
+
+extern TwoWire Wire;
+
+#endif // __WIRE_SHIM_H__
@@ -0,0 +1,320 @@
+#include <Arduino.h>
+#include <Wire.h>
+#include <EEPROM.h>
+#include "native_host.h"
+
+HardwareSerial Serial;
+TwoWire Wire;
+EEPROMClass EEPROM;
+
+// ========================================
+// VIRTUAL CLOCK
+// ========================================
+static uint64_t clock_us = 0;
+static unsigned long auto_advance_us = 0;
+
+static void (*tick_isr)() = 0;
+static unsigned long tick_period_us = 0;
+static uint64_t next_tick_us = 0;
+static bool in_tick = false;
+
+// Every clock movement goes through here so attached ticks fire in order
+static void advance_clock(uint64_t us){
+    uint64_t target = clock_us + us;
+    while(tick_isr && !in_tick && next_tick_us <= target){
+        clock_us = next_tick_us;
+        next_tick_us += tick_period_us;
+        in_tick = true;
+        tick_isr();
+        in_tick = false;
+    }
+    if(clock_us < target)
+        clock_us = target;
+}
+
+// Moving forward runs the ticks in between; moving back restarts them
+void native_set_micros(uint64_t us){
+    if(us >= clock_us){
+        advance_clock(us - clock_us);
+        return;
+    }
+    clock_us = us;
+    next_tick_us = clock_us + tick_period_us;
+}
+void native_advance_micros(uint64_t us) { advance_clock(us); }
+void native_advance_millis(unsigned long ms) { advance_clock((uint64_t)ms * 1000); }
+uint64_t native_get_micros() { return clock_us; }
+void native_set_auto_advance_micros(unsigned long us_per_read) { auto_advance_us = us_per_read; }
+
+void native_attach_tick(void (*isr)(), unsigned long period_us){
+    tick_isr = period_us ? isr : 0;
+    tick_period_us = period_us;
+    next_tick_us = clock_us + period_us;
+}
+
+unsigned long millis(){
+    advance_clock(auto_advance_us);
+    return (unsigned long)(clock_us / 1000);
+}
+
+unsigned long micros(){
+    advance_clock(auto_advance_us);
+    return (unsigned long)clock_us;
+}
+
+void delay(unsigned long ms) { advance_clock((uint64_t)ms * 1000); }
+void delayMicroseconds(unsigned int us) { advance_clock(us); }
+
+// ========================================
+// RANDOM NUMBERS
+// ========================================
+// Same contract as the AVR core: random(n) is in [0, n), random(a, b) in [a, b)
+long random(long howbig){
+    if(howbig <= 0)
+        return 0;
+    return ::random() % howbig;
+}
+
+long random(long howsmall, long howbig){
+    if(howsmall >= howbig)
+        return howsmall;
+    return random(howbig - howsmall) + howsmall;
+}
+
+void randomSeed(unsigned long seed){
+    if(seed != 0)
+        srandom((unsigned int)seed);
+}
+
+// ========================================
+// PINS
+// ========================================
+static int pin_levels[NATIVE_NUM_PINS];
+static int pin_outputs[NATIVE_NUM_PINS];
+static unsigned long pin_write_counts[NATIVE_NUM_PINS];
+static long encoder_positions[NATIVE_NUM_PINS];
+static uint8_t encoder_data_pins[NATIVE_NUM_PINS];     // 0 = pulses move the position only
+static void (*pin_isrs[NATIVE_NUM_PINS])();
+static int pin_isr_modes[NATIVE_NUM_PINS];
+
+void pinMode(uint8_t pin, uint8_t mode){
+    if(pin < NATIVE_NUM_PINS && mode == INPUT_PULLUP)
+        pin_levels[pin] = HIGH;
+}
+
+void digitalWrite(uint8_t pin, uint8_t value){
+    if(pin < NATIVE_NUM_PINS){
+        pin_outputs[pin] = value;
+        pin_write_counts[pin]++;
+    }
+}
+
+int digitalRead(uint8_t pin){
+    return pin < NATIVE_NUM_PINS ? pin_levels[pin] : LOW;
+}
+
+// Floating analog pins return noise so RandomSeed<> terminates
+int analogRead(uint8_t pin){
+    if(pin < NATIVE_NUM_PINS && pin_levels[pin] != 0)
+        return pin_levels[pin];
+    return (int)(::random() & 0x3FF);
+}
+
+void analogWrite(uint8_t pin, int value){
+    digitalWrite(pin, (uint8_t)value);
+    if(pin < NATIVE_NUM_PINS)
+        pin_outputs[pin] = value;
+}
+
+void native_set_pin(uint8_t pin, int value){
+    if(pin >= NATIVE_NUM_PINS)
+        return;
+    int old_value = pin_levels[pin];
+    pin_levels[pin] = value;
+
+    void (*isr)() = pin_isrs[pin];
+    if(!isr || (old_value != LOW) == (value != LOW))
+        return;
+    int mode = pin_isr_modes[pin];
+    if(mode == CHANGE || (mode == RISING && value != LOW) || (mode == FALLING && value == LOW))
+        isr();
+}
+
+void attachInterrupt(int interrupt, void (*isr)(), int mode){
+    if(interrupt >= 0 && interrupt < NATIVE_NUM_PINS){
+        pin_isrs[interrupt] = isr;
+        pin_isr_modes[interrupt] = mode;
+    }
+}
+
+void detachInterrupt(int interrupt){
+    if(interrupt >= 0 && interrupt < NATIVE_NUM_PINS)
+        pin_isrs[interrupt] = 0;
+}
+
+int native_get_pin(uint8_t pin){
+    return pin < NATIVE_NUM_PINS ? pin_outputs[pin] : 0;
+}
+
+unsigned long native_get_pin_write_count(uint8_t pin){
+    return pin < NATIVE_NUM_PINS ? pin_write_counts[pin] : 0;
+}
+
+void native_set_encoder_pins(uint8_t clock_pin, uint8_t data_pin){
+    if(clock_pin < NATIVE_NUM_PINS && data_pin < NATIVE_NUM_PINS)
+        encoder_data_pins[clock_pin] = data_pin;
+}
+
+// Clock/data levels in the order paulstoffregen/Encoder counts up
+static const uint8_t QUADRATURE_SEQUENCE[4][2] = {{HIGH, LOW}, {LOW, LOW}, {LOW, HIGH}, {HIGH, HIGH}};
+
+void native_turn_encoder(uint8_t clock_pin, long pulses){
+    if(clock_pin >= NATIVE_NUM_PINS)
+        return;
+    encoder_positions[clock_pin] += pulses;
+
+    uint8_t data_pin = encoder_data_pins[clock_pin];
+    if(data_pin == 0)
+        return;
+
+    int index = 0;
+    while(index < 3 && (QUADRATURE_SEQUENCE[index][0] != pin_levels[clock_pin] ||
+                        QUADRATURE_SEQUENCE[index][1] != pin_levels[data_pin]))
+        index++;
+
+    // one line changes per pulse, firing its interrupt
+    int step = pulses < 0 ? 3 : 1;
+    for(long i = pulses < 0 ? -pulses : pulses; i > 0; i--){
+        index = (index + step) & 3;
+        if(pin_levels[clock_pin] != QUADRATURE_SEQUENCE[index][0])
+            native_set_pin(clock_pin, QUADRATURE_SEQUENCE[index][0]);
+        else
+            native_set_pin(data_pin, QUADRATURE_SEQUENCE[index][1]);
+    }
+}
+
+long native_get_encoder_position(uint8_t clock_pin){
+    return clock_pin < NATIVE_NUM_PINS ? encoder_positions[clock_pin] : 0;
+}
+
+// ========================================
+// AVR LIBC EXTRAS
+// ========================================
+char *ltoa(long value, char *buffer, int radix){
+    char digits[34];
+    int n = 0;
+    bool negative = value < 0 && radix == 10;
+    unsigned long v = negative ? -(unsigned long)value : (unsigned long)value;
+    do {
+        int d = v % radix;
+        digits[n++] = d < 10 ? '0' + d : 'a' + d - 10;
+        v /= radix;
+    } while(v && n < (int)sizeof(digits));
+
+    char *p = buffer;
+    if(negative)
+        *p++ = '-';
+    while(n)
+        *p++ = digits[--n];
+    *p = '\0';
+    return buffer;
+}
+
+char *itoa(int value, char *buffer, int radix){
+    return ltoa(value, buffer, radix);
+}
+
+// ========================================
+// WIRE
+// ========================================
+TwoWire::TwoWire() : _address(0), _in_transmission(false), _transmissions(0), _bytes(0) {}
+
+void TwoWire::beginTransmission(uint8_t address){
+    _address = address;
+    _in_transmission = true;
+}
+
+size_t TwoWire::write(uint8_t data){
+    (void)data;
+    if(!_in_transmission)
+        return 0;
+    _bytes++;
+    return 1;
+}
+
+size_t TwoWire::write(const uint8_t *data, size_t quantity){
+    (void)data;
+    if(!_in_transmission)
+        return 0;
+    _bytes += quantity;
+    return quantity;
+}
+
+// Always acknowledged: there is no bus to fail
+uint8_t TwoWire::endTransmission(bool send_stop){
+    (void)send_stop;
+    if(!_in_transmission)
+        return 4;
+    _in_transmission = false;
+    _transmissions++;
+    return 0;
+}
+
+// ========================================
+// SERIAL
+// ========================================
+#define NATIVE_SERIAL_INPUT 256
+
+static char serial_input[NATIVE_SERIAL_INPUT];
+static int serial_head = 0;
+static int serial_tail = 0;
+
+void native_serial_input(const char *text){
+    while(*text){
+        int next = (serial_head + 1) % NATIVE_SERIAL_INPUT;
+        if(next == serial_tail)
+            break;
+        serial_input[serial_head] = *text++;
+        serial_head = next;
+    }
+}
+
+int HardwareSerial::available(){
+    return (serial_head - serial_tail + NATIVE_SERIAL_INPUT) % NATIVE_SERIAL_INPUT;
+}
+
+int HardwareSerial::read(){
+    if(serial_head == serial_tail)
+        return -1;
+    int c = (unsigned char)serial_input[serial_tail];
+    serial_tail = (serial_tail + 1) % NATIVE_SERIAL_INPUT;
+    return c;
+}
+
+void HardwareSerial::flush() { fflush(stdout); }
+
+size_t HardwareSerial::write(uint8_t c) { return fputc(c, stdout) == EOF ? 0 : 1; }
+
+size_t HardwareSerial::print(const char *s) { return fputs(s, stdout) == EOF ? 0 : strlen(s); }
+size_t HardwareSerial::print(const __FlashStringHelper *s) { return print(reinterpret_cast<const char *>(s)); }
+size_t HardwareSerial::print(char c) { return write(c); }
+size_t HardwareSerial::print(unsigned char n, int base) { return print((unsigned long)n, base); }
+size_t HardwareSerial::print(int n, int base) { return print((long)n, base); }
+size_t HardwareSerial::print(unsigned int n, int base) { return print((unsigned long)n, base); }
+
+size_t HardwareSerial::print(long n, int base){
+    if(base == DEC)
+        return printf("%ld", n);
+    return print((unsigned long)n, base);
+}
+
+size_t HardwareSerial::print(unsigned long n, int base){
+    if(base == DEC)
+        return printf("%lu", n);
+    char buffer[34];
+    return print(ltoa((long)n, buffer, base));
+}
+
+size_t HardwareSerial::print(double n, int digits) { return printf("%.*f", digits, n); }
+
+size_t HardwareSerial::println() { return print("\r\n"); }
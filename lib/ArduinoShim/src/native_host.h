@@ -0,0 +1,62 @@
+#ifndef __NATIVE_HOST_H__
+#define __NATIVE_HOST_H__
+
+#include <stdint.h>
+
+// ============================================================================
+// HOST CONTROLS FOR THE ARDUINO SHIM
+// ============================================================================
+// Used by host programs (src/native/) to drive what the firmware sees:
+// the virtual clock, input pin levels, encoder pulses and serial input.
+// Nothing here exists on the AVR targets.
+
+#define NATIVE_NUM_PINS 32
+
+// ========================================
+// VIRTUAL CLOCK
+// ========================================
+// The clock starts at 0 and never moves on its own. millis()/micros() read it,
+// delay()/delayMicroseconds() advance it.
+void native_set_micros(uint64_t us);
+void native_advance_micros(uint64_t us);
+void native_advance_millis(unsigned long ms);
+uint64_t native_get_micros();
+
+// Advance the clock by this much on every millis()/micros() read, so firmware
+// that spins on millis() (e.g. blocking scroll_string) still terminates.
+// Default 0 = fully manual clock.
+void native_set_auto_advance_micros(unsigned long us_per_read);
+
+// Stand-in for a periodic timer interrupt: isr runs once for every period_us
+// the clock crosses (native_set_micros() forward included), with the clock set
+// to that tick's time while it runs. Ticks are not nested; clock reads inside
+// isr do not fire further ticks. NULL detaches.
+void native_attach_tick(void (*isr)(), unsigned long period_us);
+
+// ========================================
+// PINS
+// ========================================
+// Level returned by digitalRead()/analogRead(); INPUT_PULLUP pins start HIGH
+void native_set_pin(uint8_t pin, int value);
+// Last value written by digitalWrite()/analogWrite()
+int native_get_pin(uint8_t pin);
+unsigned long native_get_pin_write_count(uint8_t pin);
+
+// ========================================
+// ENCODERS
+// ========================================
+// Adds quadrature pulses to the Encoder attached to clock_pin
+// (PULSES_PER_DETENT pulses make one detent)
+void native_turn_encoder(uint8_t clock_pin, long pulses);
+// Also step the clock and data pin levels for each pulse, firing any pin
+// interrupts attached to them (for ENABLE_INPUT_CAPTURE builds)
+void native_set_encoder_pins(uint8_t clock_pin, uint8_t data_pin);
+long native_get_encoder_position(uint8_t clock_pin);
+
+// ========================================
+// SERIAL
+// ========================================
+// Queue text to be returned by Serial.available()/Serial.read()
+void native_serial_input(const char *text);
+
+#endif // __NATIVE_HOST_H__
@@ -6,48 +6,94 @@
 HT16K33Disp::HT16K33Disp(byte address, byte num_displays){
 	set_address(address, num_displays);
 	_loop_running = false;
+	_flushes = 0;
 }
 
 void HT16K33Disp::set_address(byte address, byte num_displays){
 	_address = address;
-	_num_displays = num_displays;
+	_num_displays = num_displays > MAX_NUM_DISPLAYS ? MAX_NUM_DISPLAYS : num_displays;
 	_num_digits = _num_displays * NUM_DIGITS_PER_DISPLAY;
+	memset(_shadow, 0, sizeof(_shadow));
+	invalidate();
+}
+
+// the chips' RAM is unknown: the next flush() sends every digit
+void HT16K33Disp::invalidate(){
+	for(byte i = 0; i < MAX_NUM_DISPLAYS; i++){
+		_dirty_first[i] = 0;
+		_dirty_last[i] = NUM_DIGITS_PER_DISPLAY - 1;
+	}
 }
 
 // point to an array of ints specifying brightness levels per display
 void HT16K33Disp::init(const byte *brightLevels){
+	invalidate();
 	for(byte i = 0; i < _num_displays; i++){
-		Wire.beginTransmission(_address + i);
-		Wire.write(0x21); //normal operation mode
-		Wire.endTransmission(false);
-		Wire.beginTransmission(_address + i);
-		Wire.write(0xE0 + *(brightLevels + i));
-		Wire.endTransmission(false);
-		Wire.beginTransmission(_address + i);
-		Wire.write(0x81); //display ON, blinking OFF
-		Wire.endTransmission();
+		byte command = 0x21; //normal operation mode
+		HT16K33Twi::send(_address + i, &command, 1);
+		command = 0xE0 + *(brightLevels + i);
+		HT16K33Twi::send(_address + i, &command, 1);
+		command = 0x81; //display ON, blinking OFF
+		HT16K33Twi::send(_address + i, &command, 1);
 		clear();
 	}
 }
 
 void HT16K33Disp::write(byte digit, unsigned int data){
-	int display = digit / NUM_DIGITS_PER_DISPLAY;
+	set_digit(digit, data);
+	flush();
+}
+
+// update the shadow only, widening the display's changed span if the digit differs
+void HT16K33Disp::set_digit(byte digit, unsigned int data){
+	if(digit >= _num_digits || _shadow[digit] == (uint16_t)data)
+		return;
+	_shadow[digit] = data;
+	byte display = digit / NUM_DIGITS_PER_DISPLAY;
 	digit -= (display * NUM_DIGITS_PER_DISPLAY);
-	Wire.beginTransmission(_address + display);
-	Wire.write(digit*2);
-	Wire.write(data);
-	Wire.write(data >> 8);
-	Wire.endTransmission();
+	if(_dirty_first[display] > _dirty_last[display]){
+		_dirty_first[display] = digit;
+		_dirty_last[display] = digit;
+	} else if(digit < _dirty_first[display])
+		_dirty_first[display] = digit;
+	else if(digit > _dirty_last[display])
+		_dirty_last[display] = digit;
+}
+
+// one transmission per display with changes: start address, then the changed
+// digits low byte first, the HT16K33 auto-increments the RAM address; with
+// ENABLE_ASYNC_TWI the frame is queued and this returns straight away
+void HT16K33Disp::flush(){
+	for(byte display = 0; display < _num_displays; display++){
+		byte first = _dirty_first[display];
+		byte last = _dirty_last[display];
+		if(first > last)
+			continue;
+		const uint16_t *digits = _shadow + display * NUM_DIGITS_PER_DISPLAY;
+		byte frame[1 + NUM_DIGITS_PER_DISPLAY * 2];
+		byte count = 0;
+		frame[count++] = first*2;
+		for(byte digit = first; digit <= last; digit++){
+			frame[count++] = (uint8_t)digits[digit];
+			frame[count++] = (uint8_t)(digits[digit] >> 8);
+		}
+		HT16K33Twi::send(_address + display, frame, count);
+		_dirty_first[display] = NUM_DIGITS_PER_DISPLAY;
+		_dirty_last[display] = 0;
+		_flushes++;
+	}
 }
 
 void HT16K33Disp::segments_test(){
 	for(byte i = 0; i < _num_digits; i++)
-		write(i, (uint16_t) -1);
+		set_digit(i, (uint16_t) -1);
+	flush();
 }
 
 void HT16K33Disp::clear(){
 	for(byte i = 0; i < _num_digits; i++)
-		write(i, 0);
+		set_digit(i, 0);
+	flush();
 }
 
 // determine the displayable length of the string
@@ -90,7 +136,7 @@ void HT16K33Disp::show_string(const char * string, bool pad_blanks){
 		if(*string == 0)
 		{
 		    if(pad_blanks)// && !right_justify)
-        		write(j, char_to_segments(' '));
+        		set_digit(j, char_to_segments(' '));
 		    else
         		break;
 		}
@@ -99,14 +145,15 @@ void HT16K33Disp::show_string(const char * string, bool pad_blanks){
 		    if(*(string + 1) == '.')
 		    {
         		// take the next char and just light this positions DP LED
-        		write(j, char_to_segments(*string, true));
+        		set_digit(j, char_to_segments(*string, true));
         		string++;
 		    }
 		    else
-        		write(j, char_to_segments(*string));
+        		set_digit(j, char_to_segments(*string));
 		    string++;
 		}
 	}
+	flush();
 }
 
 void HT16K33Disp::simple_show_string(const char * string){
@@ -115,14 +162,15 @@ void HT16K33Disp::simple_show_string(const char * string){
 		    break;
 		if(*(string + 1) == '.')
 		{
-		    write(i, char_to_segments(*string, true));
+		    set_digit(i, char_to_segments(*string, true));
 		    string++;
 		}
 		else
 
-		    write(i, char_to_segments(*string));
+		    set_digit(i, char_to_segments(*string));
 		string++;
 	}
+	flush();
 }
 
 // save and restore string in case this is used along with a non-blocking scroll
@@ -203,7 +251,7 @@ uint16_t HT16K33Disp::char_to_segments(char c, bool decimal_point){
 	if(c < 32 || c > 127)
 		return (uint16_t) -1;
 #ifdef HT16K33Disp_USEPROGMEM
-    return pgm_read_dword(&HT16K33Disp_FourteenSegmentASCII[c - 32]) | (decimal_point ? DECIMAL_PT_SEGMENT : 0);
+    return pgm_read_word(&HT16K33Disp_FourteenSegmentASCII[c - 32]) | (decimal_point ? DECIMAL_PT_SEGMENT : 0);
 #else
     return HT16K33Disp_FourteenSegmentASCII[c - 32] | (decimal_point ? DECIMAL_PT_SEGMENT : 0);
 #endif
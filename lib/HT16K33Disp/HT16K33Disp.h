@@ -4,13 +4,14 @@
 // some code borrowed from https://github.com/akuzechie/HT16K33-Display-Library
 
 #include <Arduino.h>
-#include <Wire.h>
+#include "HT16K33Twi.h"
 
 #define DEFAULT_ADDRESS_ 0x70
 #define DEFAULT_NUM_DISPLAYS 1
 #define DECIMAL_PT_SEGMENT 0x4000
 
 #define NUM_DIGITS_PER_DISPLAY 4
+#define MAX_NUM_DISPLAYS 2	// sizes the shadow of the display RAM
 
 #define DEFAULT_SHOW_DELAY 750  // Restored to original value
 #define DEFAULT_SCROLL_DELAY 200
@@ -146,6 +147,7 @@ public:
 	void set_address(byte address, byte num_displays);
 
 	void write(byte digit, unsigned int data);
+	void flush();
 	void segments_test();
 	void clear();
 	int string_length(const char * string);
@@ -160,12 +162,24 @@ public:
 	bool loop_scroll_string(unsigned long time, const char * string, int show_delay = 0, int scroll_delay = 0);
 
 	uint16_t char_to_segments(char c, bool decimal_point = false);
+	unsigned long get_flush_count() const { return _flushes; }
 
 	void init(const byte *brightLevels);
 
 	static const int DEFAULT_ADDRESS = DEFAULT_ADDRESS_;
 
 private:
+	void set_digit(byte digit, unsigned int data);
+	void invalidate();
+
+	// Shadow of each chip's digit RAM; set_digit() only marks digits that
+	// differ, and flush() sends each display's changed span in one
+	// auto-increment burst
+	uint16_t _shadow[MAX_NUM_DISPLAYS * NUM_DIGITS_PER_DISPLAY];
+	byte _dirty_first[MAX_NUM_DISPLAYS];	// NUM_DIGITS_PER_DISPLAY = clean
+	byte _dirty_last[MAX_NUM_DISPLAYS];
+	unsigned long _flushes;
+
 	int _address;
 	int _num_displays;
 	int _num_digits;
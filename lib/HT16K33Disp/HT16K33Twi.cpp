@@ -0,0 +1,224 @@
+#include <Arduino.h>
+#include "HT16K33Twi.h"
+
+volatile unsigned int HT16K33Twi::_errors = 0;
+
+#ifndef HT16K33Twi_QUEUED
+
+#include <Wire.h>
+
+void HT16K33Twi::begin(){
+	Wire.begin();
+}
+
+void HT16K33Twi::send(byte address, const byte *data, byte count){
+	Wire.beginTransmission(address);
+	Wire.write(data, count);
+	if(Wire.endTransmission() != 0)
+		_errors++;
+}
+
+bool HT16K33Twi::is_idle(){
+	return true;
+}
+
+void HT16K33Twi::wait_idle(){
+}
+
+#else
+
+#define QUEUE_MASK (HT16K33Twi_QUEUE_SIZE - 1)
+
+volatile byte HT16K33Twi::_queue[HT16K33Twi_QUEUE_SIZE];
+volatile byte HT16K33Twi::_head = 0;
+volatile byte HT16K33Twi::_tail = 0;
+volatile byte HT16K33Twi::_address = 0;
+volatile byte HT16K33Twi::_remaining = 0;
+volatile bool HT16K33Twi::_busy = false;
+
+// ========================================
+// BUS CONTROL
+// ========================================
+#if defined(__AVR_ATmega328P__)
+
+#include <util/twi.h>
+
+#define TWCR_RUN (_BV(TWINT) | _BV(TWEN) | _BV(TWIE))
+
+static void bus_init(){
+	TWSR = 0;	// prescaler 1
+	TWBR = ((F_CPU / HT16K33Twi_FREQUENCY) - 16) / 2;
+	TWCR = _BV(TWEN) | _BV(TWIE);
+}
+
+// the ISR sends the address once the start is on the bus
+static void bus_start(byte address, bool stop_first){
+	(void)address;
+	if(stop_first)
+		TWCR = TWCR_RUN | _BV(TWSTO) | _BV(TWSTA);
+	else
+		TWCR = TWCR_RUN | _BV(TWSTA);
+}
+
+static void bus_write(byte data){
+	TWDR = data;
+	TWCR = TWCR_RUN;
+}
+
+static void bus_stop(){
+	TWCR = TWCR_RUN | _BV(TWSTO);
+}
+
+// a start written while the last stop is still going out would cancel it
+static void bus_wait_stop(){
+	while(TWCR & _BV(TWSTO))
+		;
+}
+
+ISR(TWI_vect){
+	switch(TW_STATUS){
+	case TW_START:
+	case TW_REP_START:
+		TWDR = HT16K33Twi::get_frame_address() << 1;
+		TWCR = TWCR_RUN;
+		break;
+	case TW_MT_SLA_ACK:
+	case TW_MT_DATA_ACK:
+		HT16K33Twi::on_ack();
+		break;
+	default:	// NACK, arbitration lost, bus error
+		HT16K33Twi::on_error();
+		break;
+	}
+}
+
+#elif defined(__AVR_ATmega4809__)
+
+static void bus_init(){
+	TWI0.MBAUD = (F_CPU / (2 * HT16K33Twi_FREQUENCY)) - 5;
+	TWI0.MCTRLB = TWI_FLUSH_bm;
+	TWI0.MCTRLA = TWI_WIEN_bm | TWI_ENABLE_bm;
+	TWI0.MSTATUS = TWI_BUSSTATE_IDLE_gc;
+}
+
+// writing the address starts the frame, or repeats the start while the bus is ours
+static void bus_start(byte address, bool stop_first){
+	(void)stop_first;
+	TWI0.MADDR = address << 1;
+}
+
+static void bus_write(byte data){
+	TWI0.MDATA = data;
+}
+
+static void bus_stop(){
+	TWI0.MCTRLB = TWI_MCMD_STOP_gc;
+}
+
+static void bus_wait_stop(){
+}
+
+ISR(TWI0_TWIM_vect){
+	byte status = TWI0.MSTATUS;
+	if(status & (TWI_ARBLOST_bm | TWI_BUSERR_bm)){
+		TWI0.MSTATUS = TWI_ARBLOST_bm | TWI_BUSERR_bm | TWI_WIF_bm;
+		HT16K33Twi::on_error();
+	} else if(status & TWI_RXACK_bm)
+		HT16K33Twi::on_error();
+	else
+		HT16K33Twi::on_ack();
+}
+
+#endif
+
+// ========================================
+// QUEUE
+// ========================================
+void HT16K33Twi::begin(){
+	// internal pull-ups, as Wire does
+	pinMode(SDA, INPUT_PULLUP);
+	pinMode(SCL, INPUT_PULLUP);
+	noInterrupts();
+	_head = _tail = 0;
+	_busy = false;
+	bus_init();
+	interrupts();
+}
+
+void HT16K33Twi::send(byte address, const byte *data, byte count){
+	if(count > HT16K33Twi_QUEUE_SIZE - 2)
+		return;
+
+	// wait for the ISR to make room; it only ever advances _tail
+	while(((_tail - _head - 1) & QUEUE_MASK) < count + 2)
+		;
+
+	byte head = _head;
+	_queue[head] = address;
+	head = (head + 1) & QUEUE_MASK;
+	_queue[head] = count;
+	head = (head + 1) & QUEUE_MASK;
+	for(byte i = 0; i < count; i++){
+		_queue[head] = data[i];
+		head = (head + 1) & QUEUE_MASK;
+	}
+
+	noInterrupts();
+	_head = head;
+	if(!_busy){
+		bus_wait_stop();
+		next_frame(false);
+	}
+	interrupts();
+}
+
+bool HT16K33Twi::is_idle(){
+	return !_busy;
+}
+
+void HT16K33Twi::wait_idle(){
+	while(_busy)
+		;
+}
+
+// ISR context, or interrupts off
+byte HT16K33Twi::pop(){
+	byte tail = _tail;
+	byte data = _queue[tail];
+	_tail = (tail + 1) & QUEUE_MASK;
+	return data;
+}
+
+// ISR context, or interrupts off: start the next queued frame, or release the bus
+void HT16K33Twi::next_frame(bool stop_first){
+	if(_tail == _head){
+		bus_stop();
+		_busy = false;
+		return;
+	}
+	_address = pop();
+	_remaining = pop();
+	_busy = true;
+	bus_start(_address, stop_first);
+}
+
+// ISR context: the address or the last byte was acknowledged
+void HT16K33Twi::on_ack(){
+	if(_remaining){
+		_remaining--;
+		bus_write(pop());
+	} else
+		next_frame(false);
+}
+
+// ISR context: drop the rest of the frame and go on with the next one
+void HT16K33Twi::on_error(){
+	while(_remaining){
+		_remaining--;
+		pop();
+	}
+	_errors++;
+	next_frame(true);
+}
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef HT16K33Twi__H__
+#define HT16K33Twi__H__
+
+#include <Arduino.h>
+
+// Transmit path for the HT16K33 displays
+//
+// By default every frame goes out through Wire, which holds the caller until
+// the last byte has been clocked out: a 9-byte flush() burst is ~1 ms of
+// main loop at the 100 kHz Wire default.
+//
+// With ENABLE_ASYNC_TWI defined on an ATmega328 or ATmega4809, send()
+// copies the frame into a small ring and returns; the TWI interrupt clocks
+// out the bytes and chains queued frames with repeated starts, so the main
+// loop only pays for the copy. A frame that does not fit waits for the ISR
+// to make room. A frame the display does not acknowledge is dropped and
+// counted, the rest of the queue still goes out.
+//
+// The queued build drives the TWI registers itself and so cannot share the
+// bus with Wire (Wire's twi.c owns the same interrupt vector): call
+// HT16K33Twi::begin() instead of Wire.begin() and keep Wire out of the
+// sketch. Host builds and other boards always use Wire.
+//
+// The flag has to reach this library's own translation unit as well as the
+// sketch, so it is set in platformio.ini build_flags, not in a header.
+
+#if defined(ENABLE_ASYNC_TWI) && (defined(__AVR_ATmega328P__) || defined(__AVR_ATmega4809__))
+#define HT16K33Twi_QUEUED
+#endif
+
+#define HT16K33Twi_FREQUENCY 400000UL	// queued build; the HT16K33 runs up to 400 kHz
+#define HT16K33Twi_QUEUE_SIZE 32		// power of two, holds frames of up to QUEUE_SIZE - 2 bytes
+
+class HT16K33Twi
+{
+public:
+	static void begin();
+	static void send(byte address, const byte *data, byte count);
+
+	static bool is_idle();
+	static void wait_idle();
+	static unsigned int get_error_count() { return _errors; }
+
+#ifdef HT16K33Twi_QUEUED
+	// TWI ISR bodies
+	static byte get_frame_address() { return _address; }
+	static void on_ack();
+	static void on_error();
+#endif
+
+private:
+#ifdef HT16K33Twi_QUEUED
+	static void next_frame(bool stop_first);
+	static byte pop();
+
+	// each frame is queued as address, count, then count data bytes
+	static volatile byte _queue[HT16K33Twi_QUEUE_SIZE];
+	static volatile byte _head;		// written by send()
+	static volatile byte _tail;		// written by the ISR
+	static volatile byte _address;	// frame on the bus
+	static volatile byte _remaining;	// its bytes still in the queue
+	static volatile bool _busy;
+#endif
+	static volatile unsigned int _errors;
+};
+
+#endif
@@ -0,0 +1,11 @@
+#ifndef MD_AD9833_H
+#define MD_AD9833_H
+
+// FluxTune builds use its own minimal AD9833 driver in place of the
+// majicdesigns/MD_AD9833 registry package, on the boards and on the host.
+// It has the same class name and the subset of the API the firmware calls,
+// plus the register word transports in MD_AD9833_Transport.h.
+
+#include <MD_AD9833_Minimal.h>
+
+#endif // MD_AD9833_H
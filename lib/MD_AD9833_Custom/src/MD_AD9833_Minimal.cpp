@@ -4,40 +4,85 @@
 
 #include "MD_AD9833_Minimal.h"
 
+#ifdef MD_AD9833_RECORDING
+#include "MD_AD9833_Recorder.h"
+
+uint8_t MD_AD9833::_chipCount = 0;
+#endif
+
 // AD9833 register definitions (only what we need)
 #define CMD_FREQ0    0x4000  // Frequency register 0
 #define CMD_FREQ1    0x8000  // Frequency register 1
 #define CMD_CONTROL  0x0000  // Control register
 #define CMD_B28      0x2000  // 28-bit frequency write
+#define CMD_HLB      0x1000  // With B28 clear: write the MSB half, else the LSB half
 #define CMD_FSELECT  0x0800  // Frequency select bit
 #define CMD_RESET    0x0100  // Reset bit
 
+// Register image not known to match the chip (after power-up or invalidate())
+#define REG_UNKNOWN  0x80000000UL
+#define HALF_MASK    0x3FFF
+
 // Default reference clock frequency (25MHz)
 #define DEFAULT_MCLK 25000000UL
 
+// Tuning word per 0.1 Hz is 2^28 / (10 * MCLK), 1.073741824 at 25 MHz; kept
+// as a 31-bit fraction so a word is one 32x32 multiply and a shift
+#define WORD_SCALE_SHIFT 31
+#define WORD_SCALE ((uint32_t)((1ULL << (28 + WORD_SCALE_SHIFT)) / (10ULL * DEFAULT_MCLK)))
+
 MD_AD9833::MD_AD9833(uint8_t dataPin, uint8_t clkPin, uint8_t fsyncPin)
-  : _dataPin(dataPin), _clkPin(clkPin), _fsyncPin(fsyncPin), _mClk(DEFAULT_MCLK)
+  : _transport(NULL), _dataPin(dataPin), _clkPin(clkPin), _fsyncPin(fsyncPin)
 {
   _regCtl = CMD_CONTROL | CMD_B28;  // Default control register
-  _regFreq[0] = 0;
-  _regFreq[1] = 0;
+  _regFreq[0] = REG_UNKNOWN;
+  _regFreq[1] = REG_UNKNOWN;
+#ifdef MD_AD9833_RECORDING
+  _chip = _chipCount++;
+#endif
 }
 
-void MD_AD9833::begin(void)
+MD_AD9833::MD_AD9833(AD9833Transport *transport, uint8_t fsyncPin)
+  : _transport(transport), _dataPin(0), _clkPin(0), _fsyncPin(fsyncPin)
+{
+  _regCtl = CMD_CONTROL | CMD_B28;
+  _regFreq[0] = REG_UNKNOWN;
+  _regFreq[1] = REG_UNKNOWN;
+#ifdef MD_AD9833_RECORDING
+  _chip = _chipCount++;
+#endif
+}
+
+void MD_AD9833::beginPins(void)
 {
   // Initialize SPI pins
-  pinMode(_dataPin, OUTPUT);
-  pinMode(_clkPin, OUTPUT);
   pinMode(_fsyncPin, OUTPUT);
-  
-  // Set initial states
   digitalWrite(_fsyncPin, HIGH);
-  digitalWrite(_clkPin, LOW);
-  digitalWrite(_dataPin, LOW);
+#ifndef NATIVE_BUILD
+  _fsyncReg = portOutputRegister(digitalPinToPort(_fsyncPin));
+  _fsyncMask = digitalPinToBitMask(_fsyncPin);
+#endif
+
+  if (_transport) {
+    _transport->begin();
+  } else {
+    pinMode(_dataPin, OUTPUT);
+    pinMode(_clkPin, OUTPUT);
+    digitalWrite(_clkPin, HIGH);  // SPI mode 2: clock idles high
+    digitalWrite(_dataPin, LOW);
+  }
+}
+
+void MD_AD9833::begin(void)
+{
+  beginPins();
   
   // Reset AD9833 and configure for sine wave output
   writeRegister(CMD_CONTROL | CMD_RESET | CMD_B28);  // Reset
   writeRegister(CMD_CONTROL | CMD_B28);              // Clear reset, ready for operation
+  _regCtl = CMD_CONTROL | CMD_B28;
+  _regFreq[0] = REG_UNKNOWN;
+  _regFreq[1] = REG_UNKNOWN;
   
   // Set both frequencies to a safe default (1kHz)
   setFrequency(CHAN_0, 1000.0);
@@ -47,20 +92,106 @@ void MD_AD9833::begin(void)
   setActiveFrequency(CHAN_0);
 }
 
+void MD_AD9833::beginAll(MD_AD9833 *chips[], uint8_t count, uint32_t word)
+{
+  for (uint8_t i = 0; i < count; i++) {
+    chips[i]->beginPins();
+    chips[i]->_regCtl = CMD_CONTROL | CMD_B28;
+    chips[i]->_regFreq[0] = REG_UNKNOWN;
+    chips[i]->_regFreq[1] = REG_UNKNOWN;
+  }
+
+  // Same sequence as begin(), each word once for all of the chips; the
+  // control word left after reset already selects channel 0
+  writeShared(chips, count, CMD_CONTROL | CMD_RESET | CMD_B28);
+  writeShared(chips, count, CMD_CONTROL | CMD_B28);
+  setFrequencyWordAll(chips, count, CHAN_0, word);
+  setFrequencyWordAll(chips, count, CHAN_1, word);
+}
+
 void MD_AD9833::setFrequency(channel_t channel, float frequency)
 {
-  if (channel > CHAN_1) return;  // Invalid channel
+  setFrequencyWord(channel, calcFreq(frequency));
+}
+
+bool MD_AD9833::setFrequencyWord(channel_t channel, uint32_t freqWord)
+{
+  if (channel > CHAN_1) return false;  // Invalid channel
   
-  // Calculate 28-bit frequency word
-  uint32_t freqWord = calcFreq(frequency);
+  freqWord &= 0x0FFFFFFFUL;
+  uint32_t last = _regFreq[channel];
+  uint16_t lsb = freqWord & HALF_MASK;
+  uint16_t msb = (freqWord >> 14) & HALF_MASK;
+  bool unknown = last & REG_UNKNOWN;
+  bool lsbChanged = unknown || lsb != (last & HALF_MASK);
+  bool msbChanged = unknown || msb != ((last >> 14) & HALF_MASK);
   _regFreq[channel] = freqWord;
   
   // Send frequency data to AD9833
   uint16_t freqCmd = (channel == CHAN_0) ? CMD_FREQ0 : CMD_FREQ1;
   
-  // Send LSB first, then MSB (28-bit transfer)
-  writeRegister(freqCmd | (freqWord & 0x3FFF));          // Lower 14 bits
-  writeRegister(freqCmd | ((freqWord >> 14) & 0x3FFF));  // Upper 14 bits
+  if (lsbChanged && msbChanged) {
+    // Send LSB first, then MSB (28-bit transfer)
+    setWriteMode(CMD_B28);
+    writeRegister(freqCmd | lsb);          // Lower 14 bits
+    writeRegister(freqCmd | msb);          // Upper 14 bits
+  } else if (lsbChanged) {
+    setWriteMode(0);                       // B28 and HLB clear: lower 14 bits
+    writeRegister(freqCmd | lsb);
+  } else if (msbChanged) {
+    setWriteMode(CMD_HLB);                 // B28 clear, HLB set: upper 14 bits
+    writeRegister(freqCmd | msb);
+  }
+  return lsbChanged || msbChanged;
+}
+
+bool MD_AD9833::setFrequencyWordAll(MD_AD9833 *chips[], uint8_t count, channel_t channel, uint32_t freqWord)
+{
+  freqWord &= 0x0FFFFFFFUL;
+  uint16_t lsb = freqWord & HALF_MASK;
+  uint16_t msb = (freqWord >> 14) & HALF_MASK;
+
+  // Send a half if it differs on any of the chips; rewriting an unchanged
+  // half on the others is harmless
+  bool lsbChanged = false;
+  bool msbChanged = false;
+  for (uint8_t i = 0; i < count; i++) {
+    uint32_t last = chips[i]->_regFreq[channel];
+    bool unknown = last & REG_UNKNOWN;
+    lsbChanged |= unknown || lsb != (last & HALF_MASK);
+    msbChanged |= unknown || msb != ((last >> 14) & HALF_MASK);
+  }
+  if (!lsbChanged && !msbChanged)
+    return false;
+
+  uint16_t mode = (lsbChanged && msbChanged) ? CMD_B28 : (lsbChanged ? 0 : CMD_HLB);
+  for (uint8_t i = 0; i < count; i++) {
+    chips[i]->setWriteMode(mode);
+    chips[i]->_regFreq[channel] = freqWord;
+  }
+
+  uint16_t freqCmd = (channel == CHAN_0) ? CMD_FREQ0 : CMD_FREQ1;
+  if (lsbChanged)
+    writeShared(chips, count, freqCmd | lsb);
+  if (msbChanged)
+    writeShared(chips, count, freqCmd | msb);
+  return true;
+}
+
+void MD_AD9833::invalidate(void)
+{
+  _regFreq[0] = REG_UNKNOWN;
+  _regFreq[1] = REG_UNKNOWN;
+  writeRegister(_regCtl);
+}
+
+void MD_AD9833::setWriteMode(uint16_t mode)
+{
+  uint16_t ctl = (_regCtl & ~(CMD_B28 | CMD_HLB)) | mode;
+  if (ctl != _regCtl) {
+    _regCtl = ctl;
+    writeRegister(_regCtl);
+  }
 }
 
 void MD_AD9833::setActiveFrequency(channel_t channel)
@@ -87,23 +218,74 @@ void MD_AD9833::setMode(mode_t mode)
 uint32_t MD_AD9833::calcFreq(float f)
 {
   // Calculate 28-bit frequency word
-  // Formula: FreqReg = (Frequency * 2^28) / MCLK
-  return (uint32_t)((f * 268435456.0) / _mClk);  // 268435456 = 2^28
+  // Formula: FreqReg = (Frequency * 2^28) / MCLK, through frequencyWord()
+  return (f > 0) ? frequencyWord((uint32_t)(f * 10.0f + 0.5f)) : 0;
+}
+
+uint32_t MD_AD9833::frequencyWord(uint32_t deciHz)
+{
+  return (uint32_t)(((uint64_t)deciHz * WORD_SCALE + (1UL << (WORD_SCALE_SHIFT - 1))) >> WORD_SCALE_SHIFT);
 }
 
 void MD_AD9833::spiSend(uint16_t data)
 {
-  // Software SPI implementation
+  // Software SPI implementation: data, then the falling edge it is sampled on
   for (int i = 15; i >= 0; i--) {
-    digitalWrite(_clkPin, LOW);
     digitalWrite(_dataPin, (data >> i) & 1);
+    digitalWrite(_clkPin, LOW);
     digitalWrite(_clkPin, HIGH);
   }
 }
 
+void MD_AD9833::selectChip(bool select)
+{
+#ifdef NATIVE_BUILD
+  digitalWrite(_fsyncPin, select ? LOW : HIGH);
+#else
+  if (!_transport) {
+    digitalWrite(_fsyncPin, select ? LOW : HIGH);
+  } else if (select) {
+    *_fsyncReg &= ~_fsyncMask;
+  } else {
+    *_fsyncReg |= _fsyncMask;
+  }
+#endif
+}
+
+void MD_AD9833::sendWord(uint16_t data)
+{
+  if (_transport)
+    _transport->send(data);
+  else
+    spiSend(data);
+}
+
 void MD_AD9833::writeRegister(uint16_t data)
 {
-  digitalWrite(_fsyncPin, LOW);   // Start transaction
-  spiSend(data);                  // Send 16-bit data
-  digitalWrite(_fsyncPin, HIGH);  // End transaction
+#ifdef MD_AD9833_RECORDING
+  ad9833_recorder.record(_chip, data);
+  return;
+#endif
+
+  selectChip(true);     // Start transaction
+  sendWord(data);       // Send 16-bit data
+  selectChip(false);    // End transaction
+}
+
+void MD_AD9833::writeShared(MD_AD9833 *chips[], uint8_t count, uint16_t data)
+{
+#ifdef MD_AD9833_RECORDING
+  // Logged per chip so replays see every register change, as one transfer
+  for (uint8_t i = 0; i < count; i++)
+    ad9833_recorder.record(chips[i]->_chip, data, i > 0);
+  return;
+#endif
+
+  if (count == 0)
+    return;
+  for (uint8_t i = 0; i < count; i++)
+    chips[i]->selectChip(true);
+  chips[0]->sendWord(data);
+  for (uint8_t i = 0; i < count; i++)
+    chips[i]->selectChip(false);
 }
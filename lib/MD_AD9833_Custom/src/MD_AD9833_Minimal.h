@@ -8,6 +8,15 @@
  * - Optimizes memory usage for dual-channel frequency switching
  * - Maintains compatibility with existing FluxTune code
  * 
+ * Register words go out through a transport (MD_AD9833_Transport.h):
+ * hardware SPI, a direct port bit-bang or a host mock, chosen by the
+ * constructor. The pin constructor keeps the original digitalWrite()
+ * software SPI.
+ *
+ * Defining MD_AD9833_RECORDING swaps the transport for the write recorder
+ * in MD_AD9833_Recorder.h: the same register words are produced, but logged
+ * with timestamps instead of clocked out of the pins.
+ *
  * Original library: https://github.com/MajicDesigns/MD_AD9833
  * License: LGPL-2.1 (same as original)
  */
@@ -16,6 +25,7 @@
 #define MD_AD9833_MINIMAL_H
 
 #include <Arduino.h>
+#include "MD_AD9833_Transport.h"
 
 /**
  * Minimal AD9833 controller class optimized for FluxTune
@@ -45,16 +55,65 @@ public:
    */
   MD_AD9833(uint8_t dataPin, uint8_t clkPin, uint8_t fsyncPin);
 
+  /**
+   * Constructor - shared transport, this chip's FSYNC pin
+   */
+  MD_AD9833(AD9833Transport *transport, uint8_t fsyncPin);
+
   /**
    * Initialize the AD9833 chip
    */
   void begin(void);
 
+  /**
+   * Initialize several chips at once, both channels set to word and
+   * channel 0 selected. See setFrequencyWordAll() for the bus requirements.
+   */
+  static void beginAll(MD_AD9833 *chips[], uint8_t count, uint32_t word);
+
   /**
    * Set frequency for specified channel
    */
   void setFrequency(channel_t channel, float frequency);
 
+  /**
+   * Set a channel from a precomputed 28-bit tuning word, no float math.
+   * Only the 14-bit halves that differ from the last word written are
+   * sent: one half goes out as an HLB write with B28 cleared, both as the
+   * usual B28 pair. The control word is rewritten only when the mode changes.
+   *
+   * Either way the register moves straight from the old word to the new
+   * one, so the selected channel can be retuned in place: with B28 set the
+   * chip loads the 28 bits on the second (MSB) write, and a lone half write
+   * is only used when the other half already matches. A word whose halves
+   * both change never goes out as two HLB writes.
+   *
+   * Returns true if any frequency data was sent, false if the register
+   * already held the word.
+   */
+  bool setFrequencyWord(channel_t channel, uint32_t word);
+
+  /**
+   * Set the same channel of several chips to one tuning word. All FSYNC
+   * lines are held low together, so each register word is clocked out once
+   * for every chip. The chips must share one transport (or the same software
+   * SPI pins). A half is sent when it differs on any of the chips; control
+   * words for the B28/HLB mode still go to each chip on its own.
+   * Returns true if any frequency data was sent.
+   */
+  static bool setFrequencyWordAll(MD_AD9833 *chips[], uint8_t count, channel_t channel, uint32_t word);
+
+  /**
+   * Forget the register images: the next write of each channel sends both
+   * halves and the control word is sent again now
+   */
+  void invalidate(void);
+
+  /**
+   * 28-bit tuning word for a frequency in tenths of a hertz (integer only)
+   */
+  static uint32_t frequencyWord(uint32_t deciHz);
+
   /**
    * Set which channel is active for output
    */
@@ -68,20 +127,32 @@ public:
 private:
   // Hardware register images - only what we need
   uint16_t  _regCtl;        // control register
-  uint32_t  _regFreq[2];    // frequency registers for both channels
-  
-  // Settings cache - minimized
-  uint32_t  _mClk;          // reference clock (25MHz default)
+  uint32_t  _regFreq[2];    // frequency registers for both channels, REG_UNKNOWN until written
   
   // SPI interface
+  AD9833Transport *_transport;  // NULL: software SPI on the pins below
   uint8_t _dataPin;         // DATA pin
   uint8_t _clkPin;          // CLOCK pin  
   uint8_t _fsyncPin;        // FSYNC pin
+#ifndef NATIVE_BUILD
+  volatile uint8_t *_fsyncReg;  // FSYNC port, for the transports
+  uint8_t _fsyncMask;
+#endif
+
+#ifdef MD_AD9833_RECORDING
+  uint8_t _chip;            // recorder chip index, construction order
+  static uint8_t _chipCount;
+#endif
   
   // Internal methods
   uint32_t calcFreq(float f);          // Calculate frequency register value
   void spiSend(uint16_t data);         // Send data via SPI
+  void beginPins(void);                // Pins, transport and FSYNC port
+  void selectChip(bool select);        // Drive FSYNC low (select) or high
+  void sendWord(uint16_t data);        // Clock out a word, FSYNC already low
   void writeRegister(uint16_t data);   // Write to AD9833 register
+  static void writeShared(MD_AD9833 *chips[], uint8_t count, uint16_t data);  // One word, all chips
+  void setWriteMode(uint16_t mode);    // B28/HLB bits of the control register
 };
 
 #endif // MD_AD9833_MINIMAL_H
@@ -0,0 +1,126 @@
+/**
+ * AD9833 write recorder implementation
+ */
+
+#include "MD_AD9833_Recorder.h"
+
+#ifdef MD_AD9833_RECORDING
+
+AD9833Recorder ad9833_recorder;
+
+static AD9833Write recorder_ring[MD_AD9833_RECORD_CAPACITY];
+
+AD9833Recorder::AD9833Recorder()
+  : _ring(recorder_ring), _resolver(NULL)
+{
+  reset();
+}
+
+void AD9833Recorder::reset()
+{
+  _total = 0;
+  _transfers = 0;
+  _unowned_total = 0;
+  _chips = 0;
+  memset(_chip_total, 0, sizeof(_chip_total));
+  memset(_owner_total, 0, sizeof(_owner_total));
+}
+
+void AD9833Recorder::record(uint8_t chip, uint16_t word, bool shared)
+{
+  uint8_t owner = _resolver ? _resolver(chip) : AD9833_NO_OWNER;
+
+  AD9833Write &entry = _ring[_total % MD_AD9833_RECORD_CAPACITY];
+  entry.time = micros();
+  entry.word = word;
+  entry.chip = chip;
+  entry.owner = owner;
+  _total++;
+  if (!shared) _transfers++;
+
+  if (chip < AD9833_MAX_CHIPS) {
+    _chip_total[chip]++;
+    if (chip >= _chips) _chips = chip + 1;
+  }
+
+  if (owner < AD9833_MAX_OWNERS)
+    _owner_total[owner]++;
+  else
+    _unowned_total++;
+}
+
+unsigned long AD9833Recorder::get_count() const
+{
+  return _total < MD_AD9833_RECORD_CAPACITY ? _total : MD_AD9833_RECORD_CAPACITY;
+}
+
+const AD9833Write &AD9833Recorder::get_write(unsigned long index) const
+{
+  // index 0 is the oldest write still in the ring
+  unsigned long first = get_dropped();
+  return _ring[(first + index) % MD_AD9833_RECORD_CAPACITY];
+}
+
+unsigned long AD9833Recorder::get_owner_total(uint8_t owner) const
+{
+  if (owner == AD9833_NO_OWNER) return _unowned_total;
+  return owner < AD9833_MAX_OWNERS ? _owner_total[owner] : 0;
+}
+
+void AD9833Recorder::print_rate(unsigned long writes, unsigned long elapsed_ms)
+{
+  Serial.print(writes);
+  Serial.print("\t");
+  Serial.print(elapsed_ms ? (writes * 1000.0) / elapsed_ms : 0.0, 2);
+  Serial.println("/s");
+}
+
+void AD9833Recorder::print_report(unsigned long elapsed_ms, owner_name_t owner_name) const
+{
+  Serial.print("AD9833 register writes: ");
+  print_rate(_total, elapsed_ms);
+  Serial.print("  bus transfers:\t");
+  print_rate(_transfers, elapsed_ms);
+
+  for (uint8_t chip = 0; chip < _chips; chip++) {
+    Serial.print("  chip ");
+    Serial.print(chip + 1);
+    Serial.print(":\t");
+    print_rate(_chip_total[chip], elapsed_ms);
+  }
+
+  // Merge owners that share a label, in order of first appearance
+  bool reported[AD9833_MAX_OWNERS] = {false};
+  for (uint8_t owner = 0; owner < AD9833_MAX_OWNERS; owner++) {
+    if (reported[owner] || _owner_total[owner] == 0) continue;
+
+    const char *name = owner_name ? owner_name(owner) : NULL;
+    unsigned long writes = 0;
+    for (uint8_t other = owner; other < AD9833_MAX_OWNERS; other++) {
+      if (reported[other]) continue;
+      const char *other_name = owner_name ? owner_name(other) : NULL;
+      bool same = name && other_name ? strcmp(name, other_name) == 0 : other == owner;
+      if (same) {
+        writes += _owner_total[other];
+        reported[other] = true;
+      }
+    }
+
+    Serial.print("  ");
+    if (name) {
+      Serial.print(name);
+    } else {
+      Serial.print("owner ");
+      Serial.print(owner);
+    }
+    Serial.print(":\t");
+    print_rate(writes, elapsed_ms);
+  }
+
+  if (_unowned_total) {
+    Serial.print("  (no owner):\t");
+    print_rate(_unowned_total, elapsed_ms);
+  }
+}
+
+#endif // MD_AD9833_RECORDING
@@ -0,0 +1,82 @@
+/**
+ * AD9833 write recorder - register traffic capture for FluxTune host tools
+ *
+ * When MD_AD9833_RECORDING is defined the minimal driver records every 16-bit
+ * register write here instead of bit-banging the SPI pins. Each entry holds the
+ * micros() timestamp, the chip index (driver construction order, AD1 = 0) and an
+ * owner tag supplied by an optional resolver, so traffic can be broken down by
+ * the station that caused it. A word broadcast to several chips is logged once
+ * per chip but counted as a single bus transfer.
+ *
+ * The ring buffer keeps the most recent MD_AD9833_RECORD_CAPACITY writes for
+ * replay; the per-chip and per-owner totals cover everything since reset().
+ */
+
+#ifndef MD_AD9833_RECORDER_H
+#define MD_AD9833_RECORDER_H
+
+#include <Arduino.h>
+
+#ifndef MD_AD9833_RECORD_CAPACITY
+#define MD_AD9833_RECORD_CAPACITY 65536UL
+#endif
+
+#define AD9833_MAX_CHIPS 8
+#define AD9833_MAX_OWNERS 32
+#define AD9833_NO_OWNER 0xFF    // write made outside any station, e.g. setup()
+
+struct AD9833Write
+{
+  unsigned long time;   // micros() at the write
+  uint16_t word;        // 16-bit register word as clocked into the chip
+  uint8_t chip;         // driver index, construction order
+  uint8_t owner;        // resolver tag or AD9833_NO_OWNER
+};
+
+class AD9833Recorder
+{
+public:
+  // returns the owner tag (< AD9833_MAX_OWNERS) of the station holding a chip
+  typedef uint8_t (*owner_resolver_t)(uint8_t chip);
+  // returns a label for an owner tag; owners with equal labels are reported together
+  typedef const char *(*owner_name_t)(uint8_t owner);
+
+  AD9833Recorder();
+
+  // shared: same bus transfer as the previous record (broadcast write)
+  void record(uint8_t chip, uint16_t word, bool shared = false);
+  void reset();
+
+  void set_owner_resolver(owner_resolver_t resolver) { _resolver = resolver; }
+
+  // Ring buffer access, oldest first
+  unsigned long get_count() const;
+  const AD9833Write &get_write(unsigned long index) const;
+  unsigned long get_dropped() const { return _total > MD_AD9833_RECORD_CAPACITY ? _total - MD_AD9833_RECORD_CAPACITY : 0; }
+
+  // Totals since reset()
+  unsigned long get_total() const { return _total; }
+  unsigned long get_transfers() const { return _transfers; }   // words clocked out of the bus
+  unsigned long get_chip_total(uint8_t chip) const { return chip < AD9833_MAX_CHIPS ? _chip_total[chip] : 0; }
+  unsigned long get_owner_total(uint8_t owner) const;
+  uint8_t get_chip_count() const { return _chips; }
+
+  // Writes/sec by chip and by owner label over elapsed_ms of activity
+  void print_report(unsigned long elapsed_ms, owner_name_t owner_name = NULL) const;
+
+private:
+  static void print_rate(unsigned long writes, unsigned long elapsed_ms);
+
+  AD9833Write *_ring;
+  unsigned long _total;
+  unsigned long _transfers;
+  unsigned long _chip_total[AD9833_MAX_CHIPS];
+  unsigned long _owner_total[AD9833_MAX_OWNERS];
+  unsigned long _unowned_total;
+  uint8_t _chips;             // highest chip index seen + 1
+  owner_resolver_t _resolver;
+};
+
+extern AD9833Recorder ad9833_recorder;
+
+#endif // MD_AD9833_RECORDER_H
@@ -0,0 +1,96 @@
+/**
+ * AD9833 register word transports
+ */
+
+#include "MD_AD9833_Transport.h"
+
+// ========================================
+// HARDWARE SPI
+// ========================================
+#ifdef MD_AD9833_HARDWARE_SPI
+
+AD9833HardwareSPI ad9833_hardware_spi;
+
+void AD9833HardwareSPI::begin(void)
+{
+#if defined(__AVR_ATmega4809__)
+  // Nano Every routes MOSI/MISO/SCK to D11/D12/D13 through PORTMUX
+#ifdef SPI_MUX
+  PORTMUX.TWISPIROUTEA = (PORTMUX.TWISPIROUTEA & ~PORTMUX_SPI0_gm) | SPI_MUX;
+#else
+  PORTMUX.TWISPIROUTEA = (PORTMUX.TWISPIROUTEA & ~PORTMUX_SPI0_gm) | PORTMUX_SPI0_ALT2_gc;
+#endif
+#else
+  // Master mode drops to slave if SS is an input pulled low; on FluxTune
+  // SS (D10) is the blue panel LED, an output anyway
+  pinMode(SS, OUTPUT);
+#endif
+  pinMode(MOSI, OUTPUT);
+  pinMode(SCK, OUTPUT);
+  digitalWrite(SCK, HIGH);  // mode 2 idle level, held by the port while the SPI is off
+}
+
+void AD9833HardwareSPI::send(uint16_t data)
+{
+#if defined(__AVR_ATmega4809__)
+  SPI0.CTRLB = SPI_SSD_bm | SPI_MODE_2_gc;
+  SPI0.CTRLA = SPI_MASTER_bm | SPI_CLK2X_bm | SPI_PRESC_DIV4_gc | SPI_ENABLE_bm;  // F_CPU/2
+  SPI0.DATA = data >> 8;
+  while (!(SPI0.INTFLAGS & SPI_IF_bm));
+  (void)SPI0.DATA;
+  SPI0.DATA = data & 0xFF;
+  while (!(SPI0.INTFLAGS & SPI_IF_bm));
+  (void)SPI0.DATA;
+  SPI0.CTRLA = 0;           // release D12 to the signal meter
+#else
+  SPCR = _BV(SPE) | _BV(MSTR) | _BV(CPOL);  // mode 2
+  SPSR = _BV(SPI2X);                        // F_CPU/2
+  SPDR = data >> 8;
+  while (!(SPSR & _BV(SPIF)));
+  SPDR = data & 0xFF;
+  while (!(SPSR & _BV(SPIF)));
+  SPCR = 0;                 // release D12 to the signal meter
+#endif
+}
+
+#endif // MD_AD9833_HARDWARE_SPI
+
+// ========================================
+// PORT BIT-BANG
+// ========================================
+AD9833PortSPI::AD9833PortSPI(uint8_t dataPin, uint8_t clkPin)
+  : _dataPin(dataPin), _clkPin(clkPin)
+{
+}
+
+void AD9833PortSPI::begin(void)
+{
+  pinMode(_dataPin, OUTPUT);
+  pinMode(_clkPin, OUTPUT);
+  digitalWrite(_clkPin, HIGH);
+#ifndef NATIVE_BUILD
+  _dataReg = portOutputRegister(digitalPinToPort(_dataPin));
+  _clkReg = portOutputRegister(digitalPinToPort(_clkPin));
+  _dataMask = digitalPinToBitMask(_dataPin);
+  _clkMask = digitalPinToBitMask(_clkPin);
+#endif
+}
+
+void AD9833PortSPI::send(uint16_t data)
+{
+  // Data first, then the falling edge the chip samples on, back to idle high
+  for (uint16_t bit = 0x8000; bit; bit >>= 1) {
+#ifdef NATIVE_BUILD
+    digitalWrite(_dataPin, (data & bit) ? HIGH : LOW);
+    digitalWrite(_clkPin, LOW);
+    digitalWrite(_clkPin, HIGH);
+#else
+    if (data & bit)
+      *_dataReg |= _dataMask;
+    else
+      *_dataReg &= ~_dataMask;
+    *_clkReg &= ~_clkMask;
+    *_clkReg |= _clkMask;
+#endif
+  }
+}
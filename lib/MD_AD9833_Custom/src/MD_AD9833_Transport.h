@@ -0,0 +1,90 @@
+/**
+ * AD9833 register word transports for the minimal MD_AD9833 driver
+ *
+ * The driver drives the chip's FSYNC line itself and hands each 16-bit word
+ * to a transport that clocks it out MSB first in SPI mode 2 (SCLK idles
+ * high, data sampled on the falling edge). All chips on a shared DATA/CLK
+ * bus share one transport object.
+ *
+ * - AD9833HardwareSPI: the AVR SPI peripheral on MOSI/SCK (D11/D13 on both
+ *   the Nano and the Nano Every), two byte transfers at F_CPU/2. The SPI is
+ *   only enabled for the duration of a word, because while it is on the
+ *   hardware forces MISO (D12, the signal meter's NeoPixel data) to input.
+ * - AD9833PortSPI: bit-bang through cached port registers, for any pair of
+ *   pins; on host builds it falls back to the shim's digitalWrite().
+ * - AD9833MockSPI: host mock that counts the words and keeps the last one.
+ *
+ * Per word: digitalWrite() bit-banging took three calls per bit, well over
+ * 100 us on a 16 MHz AVR; the port transport is a few microseconds and the
+ * hardware SPI about two.
+ */
+
+#ifndef MD_AD9833_TRANSPORT_H
+#define MD_AD9833_TRANSPORT_H
+
+#include <Arduino.h>
+
+class AD9833Transport
+{
+public:
+  /**
+   * Configure the DATA/CLK lines; safe to call once per chip on the bus
+   */
+  virtual void begin(void) = 0;
+
+  /**
+   * Clock out one register word, FSYNC is already held low by the driver
+   */
+  virtual void send(uint16_t data) = 0;
+};
+
+#if defined(__AVR_ATmega328P__) || defined(__AVR_ATmega4809__)
+#define MD_AD9833_HARDWARE_SPI
+
+class AD9833HardwareSPI : public AD9833Transport
+{
+public:
+  void begin(void);
+  void send(uint16_t data);
+};
+
+extern AD9833HardwareSPI ad9833_hardware_spi;
+#endif
+
+class AD9833PortSPI : public AD9833Transport
+{
+public:
+  AD9833PortSPI(uint8_t dataPin, uint8_t clkPin);
+
+  void begin(void);
+  void send(uint16_t data);
+
+private:
+  uint8_t _dataPin;
+  uint8_t _clkPin;
+#ifndef NATIVE_BUILD
+  volatile uint8_t *_dataReg;
+  volatile uint8_t *_clkReg;
+  uint8_t _dataMask;
+  uint8_t _clkMask;
+#endif
+};
+
+class AD9833MockSPI : public AD9833Transport
+{
+public:
+  AD9833MockSPI() : _words(0), _last(0) {}
+
+  void begin(void) {}
+  void send(uint16_t data) { _words++; _last = data; }
+
+  unsigned long get_word_count(void) const { return _words; }
+  uint16_t get_last_word(void) const { return _last; }
+  void reset_counts(void) { _words = 0; }
+
+private:
+  unsigned long _words;
+  uint16_t _last;
+};
+
+#endif // MD_AD9833_TRANSPORT_H
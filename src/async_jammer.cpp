@@ -96,6 +96,15 @@ int AsyncJammer::step_jammer(unsigned long time)
     }
 }
 
+unsigned long AsyncJammer::get_next_event_time() const
+{
+    if (_next_event_time == 0) {
+        return 0;
+    }
+    unsigned long next_drift_time = _last_drift_time + JAMMER_STEP_INTERVAL;
+    return (next_drift_time < _next_event_time) ? next_drift_time : _next_event_time;
+}
+
 void AsyncJammer::apply_brownian_drift()
 {
     // Apply velocity-based brownian motion for realistic frequency wandering
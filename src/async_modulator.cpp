@@ -14,6 +14,7 @@ AsyncModulator::AsyncModulator() {
     async_next_event = 0L;
     async_active = false;
     async_switched_on = false;
+    async_prng = 1;
 }
 
 // ========================================
@@ -55,3 +56,19 @@ char AsyncModulator::get_current_char() const {
     }
     return '\0';
 }
+
+// ========================================
+// PER-MODULATOR RANDOM NUMBERS
+// ========================================
+void AsyncModulator::seed_random() {
+    async_prng = (uint16_t)random(1, 65536L);
+}
+
+uint16_t AsyncModulator::next_random(uint16_t range) {
+    uint16_t x = async_prng;
+    x ^= x << 7;
+    x ^= x >> 9;
+    x ^= x << 8;
+    async_prng = x;
+    return x % range;
+}
@@ -127,6 +127,7 @@ bool AsyncMorse::start_step_element(unsigned long time){
 }
 
 void AsyncMorse::start_transmission(const char *s, int wpm){
+    seed_random();
     set_string(s);
     set_element_delay(MORSE_TIME_FROM_WPM(wpm));
 
@@ -187,7 +188,7 @@ unsigned long AsyncMorse::compute_element_time(unsigned long time, byte element_
         
         // Generate random variation (both positive and negative)
         if (variation_percent > 0) {
-            int random_variation = (random(variation_percent * 2 + 1)) - variation_percent;
+            int random_variation = (int)next_random(variation_percent * 2 + 1) - variation_percent;
             // Apply the variation more safely
             long variation = ((long)base_time * random_variation) / 100;
             long new_time = (long)base_time + variation;
@@ -53,7 +53,7 @@ unsigned char AsyncRTTY::get_baudot_code(char c) {
 #ifdef RTTY_RANDOM_BITS_ONLY
     // Memory optimization: return random 5-bit value instead of real Baudot
     // This saves ~128 bytes Flash but RTTY will sound authentic
-    return random(32);     // Random 5-bit value (0-31)
+    return next_random(32);     // Random 5-bit value (0-31), ISR-safe
 #elif defined(USE_EEPROM_TABLES)
     // Use EEPROM-based lookup (slower but saves Flash)
     if (c >= 0 && c < 128) {
@@ -76,6 +76,7 @@ bool AsyncRTTY::start_step_element(unsigned long time){
 }
 
 void AsyncRTTY::start_rtty_message(const char* message, bool repeat) {
+    seed_random();
     async_repeat = repeat;
     set_active(false);
     set_next_event_time(0L);
@@ -2,6 +2,7 @@
 #include "bfo.h"
 #include "utils.h"
 #include "buffers.h"
+#include "displays.h"
 #include <stdlib.h>  // For itoa()
 #include <string.h>  // For strcpy(), strcat()
 
@@ -28,5 +29,5 @@ void BFO::update_display(HT16K33Disp *display){
     itoa(option_bfo_offset, freq_str, 10);
     strcpy(display_text_buffer, freq_str);
     strcat(display_text_buffer, " Hz");
-    display->scroll_string(display_text_buffer, 1, 1);
+    display_task.show(display_text_buffer);
 }
@@ -11,9 +11,11 @@ BFOHandler::BFOHandler(Mode * mode) : ModeHandler(mode)
 bool BFOHandler::event_sink(int event, int event_data){
     BFO *bfo = (BFO*) _mode;
 
-    if(event == 1){
+    // event is the signed number of detents turned since the last pass
+    for(int i = 0; i < event; i++){
         bfo->next_option();
-    } else if(event == -1){
+    }
+    for(int i = 0; i > event; i--){
         bfo->prev_option();
     }
 
@@ -3,6 +3,7 @@
 #include "contrast.h"
 #include "utils.h"
 #include "buffers.h"
+#include "displays.h"
 
 Contrast::Contrast(const char *title) : Option(title)
 {
@@ -25,5 +26,5 @@ void Contrast::update_display(HT16K33Disp *display){
 	const byte display_brightnesses[] = {(unsigned char)option_contrast, (unsigned char)option_contrast};
 	display->init(display_brightnesses);
     sprintf(display_text_buffer, "Level %d", option_contrast);
-    display->scroll_string(display_text_buffer, 1, 1);
+    display_task.show(display_text_buffer);
 }
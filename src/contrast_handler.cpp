@@ -14,9 +14,11 @@ bool ContrastHandler::event_sink(int event, int event_data){
     Contrast *contrast = (Contrast*) _mode;
 
     // unsigned long _old_freq = vfo->_frequency;
-    if(event == 1){
+    // event is the signed number of detents turned since the last pass
+    for(int i = 0; i < event; i++){
         contrast->next_option();
-    } else if(event == -1){
+    }
+    for(int i = 0; i > event; i--){
         contrast->prev_option();
     }
 
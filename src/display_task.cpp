@@ -0,0 +1,77 @@
+#include "display_task.h"
+
+DisplayTask::DisplayTask(HT16K33Disp *display)
+{
+    _display = display;
+    _first = 0;
+    _count = 0;
+    _started = false;
+}
+
+DisplayTask::Message *DisplayTask::add(const char *text, int show_delay, int scroll_delay, bool replaceable)
+{
+    Message *message;
+    if (_count < DISPLAY_TASK_QUEUE) {
+        _count++;
+        message = &last();
+    } else {
+        // Full: the newest wins over the last one waiting
+        message = &last();
+    }
+    strncpy(message->text, text, DISPLAY_TASK_TEXT - 1);
+    message->text[DISPLAY_TASK_TEXT - 1] = '\0';
+    message->show_delay = show_delay;
+    message->scroll_delay = scroll_delay;
+    message->replaceable = replaceable;
+    return message;
+}
+
+void DisplayTask::queue(const char *text, int show_delay, int scroll_delay)
+{
+    add(text, show_delay, scroll_delay, false);
+}
+
+void DisplayTask::show(const char *text, int show_delay, int scroll_delay)
+{
+    if (_count > 0 && last().replaceable) {
+        // Supersede the last value shown or waiting, restarting it if it is on now
+        if (_count == 1) {
+            _started = false;
+        }
+        strncpy(last().text, text, DISPLAY_TASK_TEXT - 1);
+        last().show_delay = show_delay;
+        last().scroll_delay = scroll_delay;
+    } else {
+        add(text, show_delay, scroll_delay, true);
+    }
+
+    // Nothing ahead of it: on the display now rather than next pass
+    if (_count == 1) {
+        step(millis());
+    }
+}
+
+void DisplayTask::clear()
+{
+    _count = 0;
+    _started = false;
+}
+
+bool DisplayTask::step(unsigned long time)
+{
+    while (_count > 0) {
+        Message &message = _messages[_first];
+        if (!_started) {
+            _display->begin_scroll_string(message.text, message.show_delay, message.scroll_delay);
+            _started = true;
+        }
+        if (_display->step_scroll_string(time)) {
+            return true;
+        }
+        // Finished, the next message starts in this same pass
+        _first = (_first + 1) % DISPLAY_TASK_QUEUE;
+        _count--;
+        _started = false;
+    }
+    return false;
+}
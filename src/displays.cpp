@@ -3,3 +3,5 @@
 
 // Main display object representing both physical displays (8 chars total)
 HT16K33Disp display(0x70, 2);
+
+DisplayTask display_task(&display);
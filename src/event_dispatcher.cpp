@@ -36,13 +36,14 @@ bool EventDispatcher::dispatch_event(HT16K33Disp *display, int encoder_id, int e
 
         case ID_ENCODER_MODES:
         {
-            if(event == 1){
+            // one mode per batch of detents, however far the knob turned
+            if(event > 0){
                 int handler = _ncurrent_handler + 1;
                 if(handler >= _nhandlers)
                 handler = 0; 
                 set_mode(display, handler);
                 return true;
-            } else if(event == -1){
+            } else if(event < 0){
                 int handler = _ncurrent_handler - 1;
                 if(handler < 0)
                 handler = _nhandlers - 1; 
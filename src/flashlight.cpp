@@ -2,6 +2,7 @@
 #include "flashlight.h"
 #include "utils.h"
 #include "buffers.h"
+#include "displays.h"
 #include "signal_meter.h"
 
 // External reference to signal meter (defined in main.cpp)
@@ -43,7 +44,7 @@ void Flashlight::update_display(HT16K33Disp *display){
     } else {
         sprintf(display_text_buffer, "FLuX %3d", option_flashlight);  // Right-align the number in 3 characters
     }
-    display->scroll_string(display_text_buffer, 1, 1);
+    display_task.show(display_text_buffer);
 
     // Update signal meter LEDs to reflect current flashlight setting
     // This ensures the LEDs show the correct state when the option is first displayed
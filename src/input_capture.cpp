@@ -0,0 +1,232 @@
+#include "input_capture.h"
+
+#ifdef ENABLE_INPUT_CAPTURE
+
+#include <Encoder.h>
+#include "encoder_handler.h"
+
+#define INPUT_RING_MASK (INPUT_CAPTURE_RING_SIZE - 1)
+
+#define PIN_CLOCK  0x01
+#define PIN_DATA   0x02
+#define PIN_BUTTON 0x04
+
+// Quadrature steps by (new data, new clock, old data, old clock), as in
+// paulstoffregen/Encoder so the direction matches the polled build; a
+// skipped state counts two steps in the direction it most likely went
+static const int8_t QUADRATURE_STEPS[16] PROGMEM = {
+    0, 1, -1, 2, -1, 0, -2, 1, 1, -2, 0, -1, 2, -1, 1, 0
+};
+
+volatile InputCapture::InputEvent InputCapture::_ring[INPUT_CAPTURE_RING_SIZE];
+volatile uint8_t InputCapture::_head = 0;
+volatile uint8_t InputCapture::_tail = 0;
+InputCapture::Channel InputCapture::_channels[INPUT_CAPTURE_CHANNELS];
+unsigned int InputCapture::_overflows = 0;
+bool InputCapture::_running = false;
+
+void InputCapture::attach(byte channel, EncoderHandler *handler, uint8_t clock_pin, uint8_t data_pin,
+                          uint8_t button_pin, byte pulses_per_detent)
+{
+    if (channel >= INPUT_CAPTURE_CHANNELS) {
+        return;
+    }
+    Channel &c = _channels[channel];
+    c.handler = handler;
+    c.clock_pin = clock_pin;
+    c.data_pin = data_pin;
+    c.button_pin = button_pin;
+    c.pulses_per_detent = pulses_per_detent ? pulses_per_detent : 1;
+}
+
+uint8_t InputCapture::read_pins(const Channel &c)
+{
+#ifdef NATIVE_BUILD
+    return (digitalRead(c.clock_pin) ? PIN_CLOCK : 0) |
+           (digitalRead(c.data_pin) ? PIN_DATA : 0) |
+           (digitalRead(c.button_pin) ? PIN_BUTTON : 0);
+#else
+    return ((*c.clock_reg & c.clock_mask) ? PIN_CLOCK : 0) |
+           ((*c.data_reg & c.data_mask) ? PIN_DATA : 0) |
+           ((*c.button_reg & c.button_mask) ? PIN_BUTTON : 0);
+#endif
+}
+
+// ISR context
+void InputCapture::push(byte channel, uint8_t event, unsigned long time)
+{
+    Channel &c = _channels[channel];
+    bool detent = event == INPUT_EVENT_DETENT_CW || event == INPUT_EVENT_DETENT_CCW;
+
+    // Once something has been held back, keep holding back events of the
+    // same kind so drain() hands them over in order
+    uint8_t next = (_head + 1) & INPUT_RING_MASK;
+    if (next == _tail || (detent ? c.lost_detents != 0 : c.lost_button)) {
+        if (detent) {
+            c.lost_detents += (event == INPUT_EVENT_DETENT_CW) ? 1 : -1;
+        } else {
+            c.lost_button = true;
+        }
+        _overflows++;
+        return;
+    }
+
+    _ring[_head].time = time;
+    _ring[_head].code = (channel << 2) | event;
+    _head = next;
+}
+
+// ISR context
+void InputCapture::service(byte channel)
+{
+    Channel &c = _channels[channel];
+    if (!c.handler) {
+        return;
+    }
+
+    uint8_t pins = read_pins(c);
+    unsigned long time = micros();
+
+    uint8_t state = pins & (PIN_CLOCK | PIN_DATA);
+    if (state != c.quad_state) {
+        c.pulses += (int8_t)pgm_read_byte(&QUADRATURE_STEPS[(state << 2) | c.quad_state]);
+        c.quad_state = state;
+        while (c.pulses >= (int8_t)c.pulses_per_detent) {
+            c.pulses -= c.pulses_per_detent;
+            push(channel, INPUT_EVENT_DETENT_CW, time);
+        }
+        while (c.pulses <= -(int8_t)c.pulses_per_detent) {
+            c.pulses += c.pulses_per_detent;
+            push(channel, INPUT_EVENT_DETENT_CCW, time);
+        }
+    }
+
+    bool down = !(pins & PIN_BUTTON);
+    if (down != c.button_down) {
+        c.button_down = down;
+        push(channel, down ? INPUT_EVENT_BUTTON_DOWN : INPUT_EVENT_BUTTON_UP, time);
+    }
+}
+
+void InputCapture::drain()
+{
+    while (_tail != _head) {
+        uint8_t tail = _tail;
+        unsigned long time = _ring[tail].time;
+        uint8_t code = _ring[tail].code;
+        _tail = (tail + 1) & INPUT_RING_MASK;
+
+        EncoderHandler *handler = _channels[code >> 2].handler;
+        switch (code & 3) {
+            case INPUT_EVENT_DETENT_CW:
+                handler->add_detents(1, time);
+                break;
+            case INPUT_EVENT_DETENT_CCW:
+                handler->add_detents(-1, time);
+                break;
+            case INPUT_EVENT_BUTTON_DOWN:
+                handler->captured_button(true, time);
+                break;
+            case INPUT_EVENT_BUTTON_UP:
+                handler->captured_button(false, time);
+                break;
+        }
+    }
+
+    // What found the ring full, after everything that was queued before it
+    for (byte i = 0; i < INPUT_CAPTURE_CHANNELS; i++) {
+        Channel &c = _channels[i];
+        if (!c.handler) {
+            continue;
+        }
+        noInterrupts();
+        int lost_detents = c.lost_detents;
+        bool lost_button = c.lost_button;
+        bool down = c.button_down;
+        c.lost_detents = 0;
+        c.lost_button = false;
+        interrupts();
+
+        if (lost_detents) {
+            c.handler->add_detents(lost_detents, micros());
+        }
+        if (lost_button) {
+            c.handler->captured_button(down, micros());
+        }
+    }
+}
+
+// ========================================
+// INTERRUPT SOURCE
+// ========================================
+#if defined(__AVR_ATmega328P__)
+
+static void enable_pin_change(uint8_t pin)
+{
+    *digitalPinToPCMSK(pin) |= bit(digitalPinToPCMSKbit(pin));
+    PCIFR |= bit(digitalPinToPCICRbit(pin));
+    PCICR |= bit(digitalPinToPCICRbit(pin));
+}
+
+#define ENABLE_PIN_INTERRUPT(pin, channel) enable_pin_change(pin)
+
+static void service_all()
+{
+    for (byte i = 0; i < INPUT_CAPTURE_CHANNELS; i++) {
+        InputCapture::service(i);
+    }
+}
+
+ISR(PCINT0_vect) { service_all(); }
+ISR(PCINT1_vect) { service_all(); }
+ISR(PCINT2_vect) { service_all(); }
+
+#elif defined(__AVR_ATmega4809__) || defined(NATIVE_BUILD)
+
+static void service_channel0() { InputCapture::service(0); }
+static void service_channel1() { InputCapture::service(1); }
+
+#define ENABLE_PIN_INTERRUPT(pin, channel) \
+    attachInterrupt(digitalPinToInterrupt(pin), (channel) == 0 ? service_channel0 : service_channel1, CHANGE)
+
+#else
+#error "ENABLE_INPUT_CAPTURE: no pin change interrupt source for this board"
+#endif
+
+void InputCapture::begin()
+{
+    noInterrupts();
+    for (byte i = 0; i < INPUT_CAPTURE_CHANNELS; i++) {
+        Channel &c = _channels[i];
+        if (!c.handler) {
+            continue;
+        }
+        pinMode(c.clock_pin, INPUT_PULLUP);
+        pinMode(c.data_pin, INPUT_PULLUP);
+        pinMode(c.button_pin, INPUT_PULLUP);
+#ifndef NATIVE_BUILD
+        c.clock_reg = portInputRegister(digitalPinToPort(c.clock_pin));
+        c.data_reg = portInputRegister(digitalPinToPort(c.data_pin));
+        c.button_reg = portInputRegister(digitalPinToPort(c.button_pin));
+        c.clock_mask = digitalPinToBitMask(c.clock_pin);
+        c.data_mask = digitalPinToBitMask(c.data_pin);
+        c.button_mask = digitalPinToBitMask(c.button_pin);
+#endif
+        uint8_t pins = read_pins(c);
+        c.quad_state = pins & (PIN_CLOCK | PIN_DATA);
+        c.pulses = 0;
+        c.button_down = !(pins & PIN_BUTTON);
+        if (c.button_down) {
+            // held since before begin()
+            push(i, INPUT_EVENT_BUTTON_DOWN, micros());
+        }
+
+        ENABLE_PIN_INTERRUPT(c.clock_pin, i);
+        ENABLE_PIN_INTERRUPT(c.data_pin, i);
+        ENABLE_PIN_INTERRUPT(c.button_pin, i);
+    }
+    _running = true;
+    interrupts();
+}
+
+#endif // ENABLE_INPUT_CAPTURE
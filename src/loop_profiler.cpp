@@ -0,0 +1,141 @@
+#include "loop_profiler.h"
+
+LoopProfiler::LoopProfiler()
+{
+    reset();
+    _pass_start = 0;
+    _phase_start = 0;
+}
+
+void LoopProfiler::begin_pass()
+{
+    _pass_start = micros();
+    _phase_start = _pass_start;
+}
+
+void LoopProfiler::end_phase(byte phase)
+{
+    unsigned long now = micros();
+    record(phase, now - _phase_start);
+    _phase_start = now;
+}
+
+void LoopProfiler::end_pass()
+{
+    record(LOOP_PHASE_TOTAL, micros() - _pass_start);
+}
+
+byte LoopProfiler::bucket_for(unsigned long duration)
+{
+    byte bucket = 0;
+    while (duration > 1 && bucket < LOOP_PROFILER_BUCKETS - 1) {
+        duration >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+void LoopProfiler::record(byte phase, unsigned long duration)
+{
+    if (phase >= LOOP_PROFILER_PHASES) return;
+
+    uint16_t *buckets = _buckets[phase];
+    byte bucket = bucket_for(duration);
+    if (buckets[bucket] == 0xFFFF) {
+        // Halve the whole histogram rather than clip one bucket
+        for (byte i = 0; i < LOOP_PROFILER_BUCKETS; i++) {
+            buckets[i] >>= 1;
+        }
+    }
+    buckets[bucket]++;
+
+    _count[phase]++;
+    if (duration < _min[phase]) _min[phase] = duration;
+    if (duration > _max[phase]) _max[phase] = duration;
+}
+
+void LoopProfiler::reset()
+{
+    memset(_buckets, 0, sizeof(_buckets));
+    for (byte phase = 0; phase < LOOP_PROFILER_PHASES; phase++) {
+        _count[phase] = 0;
+        _min[phase] = 0xFFFFFFFFUL;
+        _max[phase] = 0;
+    }
+}
+
+unsigned long LoopProfiler::get_percentile(byte phase, byte percent) const
+{
+    const uint16_t *buckets = _buckets[phase];
+    unsigned long total = 0;
+    for (byte i = 0; i < LOOP_PROFILER_BUCKETS; i++) {
+        total += buckets[i];
+    }
+    if (total == 0) return 0;
+
+    // Smallest bucket whose cumulative count reaches the percentile
+    unsigned long threshold = (total * percent + 99) / 100;
+    unsigned long cumulative = 0;
+    for (byte i = 0; i < LOOP_PROFILER_BUCKETS; i++) {
+        cumulative += buckets[i];
+        if (cumulative >= threshold) {
+            if (i == LOOP_PROFILER_BUCKETS - 1) return _max[phase];
+            unsigned long upper = (2UL << i) - 1;
+            return upper < _max[phase] ? upper : _max[phase];
+        }
+    }
+    return _max[phase];
+}
+
+bool LoopProfiler::handle_command(char command)
+{
+    switch (command) {
+        case 'p':
+        case 'P':
+            dump();
+            return true;
+        case 'r':
+        case 'R':
+            reset();
+            Serial.println(F("profiler reset"));
+            return true;
+    }
+    return false;
+}
+
+void LoopProfiler::print_phase_name(byte phase)
+{
+    switch (phase) {
+        case LOOP_PHASE_SIGNAL_METER:     Serial.print(F("meter   ")); break;
+        case LOOP_PHASE_STATION_MANAGER:  Serial.print(F("stations")); break;
+        case LOOP_PHASE_PANEL_LED:        Serial.print(F("panelled")); break;
+        case LOOP_PHASE_REALIZATION_POOL: Serial.print(F("realize ")); break;
+        case LOOP_PHASE_ENCODERS:         Serial.print(F("encoders")); break;
+        case LOOP_PHASE_TITLE_DISPLAY:    Serial.print(F("title   ")); break;
+        case LOOP_PHASE_DISPATCH:         Serial.print(F("dispatch")); break;
+        case LOOP_PHASE_TOTAL:            Serial.print(F("TOTAL   ")); break;
+    }
+}
+
+void LoopProfiler::dump()
+{
+    // Times in microseconds; bucket n holds 2^n..2^(n+1)-1 us
+    Serial.println(F("phase\tcount\tmin\tp99<=\tmax\tbuckets 1us..32ms"));
+    for (byte phase = 0; phase < LOOP_PROFILER_PHASES; phase++) {
+        print_phase_name(phase);
+        Serial.print('\t');
+        Serial.print(_count[phase]);
+        Serial.print('\t');
+        Serial.print(get_min(phase));
+        Serial.print('\t');
+        Serial.print(get_percentile(phase, 99));
+        Serial.print('\t');
+        Serial.print(_max[phase]);
+        Serial.print('\t');
+        for (byte i = 0; i < LOOP_PROFILER_BUCKETS; i++) {
+            Serial.print(_buckets[phase][i]);
+            Serial.print(' ');
+        }
+        Serial.println();
+    }
+}
@@ -1,7 +1,7 @@
 #include "station_config.h"
 
 #include <Arduino.h>
-#include <Wire.h>
+#include <HT16K33Twi.h>
 #include <MD_AD9833.h>
 #include <Encoder.h>
 #include <Adafruit_NeoPixel.h>
@@ -61,6 +61,12 @@
 #include "async_morse.h"
 
 #include "wave_gen_pool.h"
+#include "loop_profiler.h"
+#include "stack_monitor.h"
+#include "tuning_latency.h"
+#include "modulation_tick.h"
+#include "input_capture.h"
+#include "ram_budget.h"
 
 #ifdef USE_EEPROM_TABLES
 #include "eeprom_tables.h"
@@ -113,10 +119,14 @@ const byte PIN_FSYNC2 = 14;  ///< SPI Load pin number (FSYNC in AD9833 usage)
 const byte PIN_FSYNC3 = 15;  ///< SPI Load pin number (FSYNC in AD9833 usage)
 const byte PIN_FSYNC4 = 16;  ///< SPI Load pin number (FSYNC in AD9833 usage)
 
-MD_AD9833 AD1(PIN_DATA, PIN_CLK, PIN_FSYNC1); // Arbitrary SPI pins
-MD_AD9833 AD2(PIN_DATA, PIN_CLK, PIN_FSYNC2); // Arbitrary SPI pins
-MD_AD9833 AD3(PIN_DATA, PIN_CLK, PIN_FSYNC3); // Arbitrary SPI pins
-MD_AD9833 AD4(PIN_DATA, PIN_CLK, PIN_FSYNC4); // Arbitrary SPI pins
+// DATA and CLK are the MOSI/SCK pins, so the four chips share the SPI
+// peripheral; wired elsewhere, use AD9833PortSPI ad9833_bus(PIN_DATA, PIN_CLK)
+static_assert(PIN_DATA == MOSI && PIN_CLK == SCK, "AD9833 hardware SPI needs DATA on MOSI and CLK on SCK");
+
+MD_AD9833 AD1(&ad9833_hardware_spi, PIN_FSYNC1);
+MD_AD9833 AD2(&ad9833_hardware_spi, PIN_FSYNC2);
+MD_AD9833 AD3(&ad9833_hardware_spi, PIN_FSYNC3);
+MD_AD9833 AD4(&ad9833_hardware_spi, PIN_FSYNC4);
 
 WaveGen wavegen1(&AD1);
 WaveGen wavegen2(&AD2);
@@ -130,6 +140,21 @@ WaveGenPool wave_gen_pool(wavegens, realizer_stats, 4);
 // Signal meter instance
 SignalMeter signal_meter;
 
+#ifdef ENABLE_LOOP_PROFILER
+LoopProfiler loop_profiler;
+#endif
+
+#ifdef ENABLE_STACK_MONITOR
+StackMonitor stack_monitor;
+#endif
+
+#ifdef ENABLE_TUNING_LATENCY
+TuningLatency tuning_latency;
+#endif
+
+// End of a main loop phase: profiler timing and stack high-water check
+#define LOOP_PHASE_END(phase) PROFILE_PHASE(phase); STACK_CHECK(phase)
+
 // ============================================================================
 // STATION CONFIGURATION - Conditional compilation based on station_config.h
 // ============================================================================
@@ -549,6 +574,12 @@ bool realization_stats[2] = {false, false};  // *** ACTUAL STATION COUNT: 2 stat
 bool realization_stats[4] = {false, false, false, false};
 #endif
 
+// Keep the compile-time RAM model (ram_budget.h) in step with the arrays above
+static_assert(sizeof(realizations) / sizeof(realizations[0]) == RAM_MODEL_STATION_COUNT,
+              "realizations[] size does not match the station counts in ram_budget.h");
+static_assert(sizeof(realization_stats) / sizeof(realization_stats[0]) == RAM_MODEL_STATS_COUNT,
+              "realization_stats[] size does not match the station counts in ram_budget.h");
+
 #ifdef CONFIG_MINIMAL_CW
 RealizationPool realization_pool(realizations, realization_stats, 1);  // *** CRITICAL: Count must match arrays above! ***
 #elif defined(CONFIG_TEST_PERFORMANCE)
@@ -619,7 +650,7 @@ int current_dispatcher = 1;
 #define APP_SETTINGS 2
 
 void setup_display(){
-	Wire.begin();
+	HT16K33Twi::begin();
 
 	const byte display_brightnesses[] = {(unsigned char)option_contrast, (unsigned char)option_contrast};
 	display.init(display_brightnesses);
@@ -649,6 +680,10 @@ void setup_buttons(){
 }
 
 void setup(){
+#ifdef ENABLE_STACK_MONITOR
+	// First, so every later stack frame lands on painted RAM
+	stack_monitor.paint();
+#endif
 	Serial.begin(115200);
 	
 	randomizer.randomize();
@@ -667,29 +702,24 @@ void setup(){
 	setup_display();
 	setup_signal_meter();
 
-	AD1.begin();
-	AD1.setFrequency((MD_AD9833::channel_t)0, 0.1);
-	AD1.setFrequency((MD_AD9833::channel_t)1, 0.1);
-	AD1.setMode(MD_AD9833::MODE_SINE);
-
-	AD2.begin();
-	AD2.setFrequency((MD_AD9833::channel_t)0, 0.1);
-	AD2.setFrequency((MD_AD9833::channel_t)1, 0.1);
-	AD2.setMode(MD_AD9833::MODE_SINE);
-
-	AD3.begin();
-	AD3.setFrequency((MD_AD9833::channel_t)0, 0.1);
-	AD3.setFrequency((MD_AD9833::channel_t)1, 0.1);
-	AD3.setMode(MD_AD9833::MODE_SINE);
-	
-	AD4.begin();
-	AD4.setFrequency((MD_AD9833::channel_t)0, 0.1);
-	AD4.setFrequency((MD_AD9833::channel_t)1, 0.1);
-	AD4.setMode(MD_AD9833::MODE_SINE);
+	// The four AD9833s share DATA/CLK: reset and silence them all together
+	MD_AD9833 *ad9833s[4] = {&AD1, &AD2, &AD3, &AD4};
+	MD_AD9833::beginAll(ad9833s, 4, WaveGen::tuning_word(0.1));
 
 	// Initialize StationManager with dynamic pipelining
 	station_manager.enableDynamicPipelining(true);
 	station_manager.setupPipeline(7000000); // Start with VFO A frequency
+
+#ifdef ENABLE_MODULATION_TICK
+	// Morse/RTTY keying from the timer interrupt from here on
+	ModulationKeyer::begin();
+#endif
+#ifdef ENABLE_INPUT_CAPTURE
+	// Encoders and buttons from the pin change interrupts from here on
+	InputCapture::begin();
+#endif
+
+	STACK_CHECK(STACK_PHASE_SETUP);
 }
 
 #ifdef ENABLE_BRANDING_MODE
@@ -770,7 +800,7 @@ EventDispatcher * set_application(int application, HT16K33Disp *display){
 			current_dispatcher = APP_SETTINGS;
 			title = (FSTR("Settings"));
 		break;	}
-	display->scroll_string(title, DISPLAY_SHOW_TIME, DISPLAY_SCROLL_TIME);
+	display_task.queue(title, DISPLAY_SHOW_TIME, DISPLAY_SCROLL_TIME);
 
 	// we don't need this after removing the "Wave Gen" application that overtook the wave generators
 	// // Mark hardware state as dirty when switching to SimRadio  
@@ -809,16 +839,43 @@ void purge_events(){
 	      encoder_handlerB.pressed() || encoder_handlerB.long_pressed());
 }
 
+// Serial commands for the diagnostics enabled in station_config.h
+void poll_diagnostics(){
+#if defined(ENABLE_LOOP_PROFILER) || defined(ENABLE_STACK_MONITOR) || defined(ENABLE_TUNING_LATENCY)
+	while(Serial.available() > 0){
+		char command = Serial.read();
+#ifdef ENABLE_LOOP_PROFILER
+		if(loop_profiler.handle_command(command))
+			continue;
+#endif
+#ifdef ENABLE_TUNING_LATENCY
+		if(tuning_latency.handle_command(command))
+			continue;
+#endif
+#ifdef ENABLE_STACK_MONITOR
+		bool was_showing = stack_monitor.is_showing();
+		if(stack_monitor.handle_command(command) && was_showing && !stack_monitor.is_showing())
+			dispatcher->update_display(&display);  // leaving the diagnostic display
+#endif
+	}
+#endif
+}
+
 void loop()
 {
-    display.scroll_string(FSTR("FLuXTuNE"), DISPLAY_SHOW_TIME, DISPLAY_SCROLL_TIME);
+    display_task.queue(FSTR("FLuXTuNE"), DISPLAY_SHOW_TIME, DISPLAY_SCROLL_TIME);
 
 #ifdef ENABLE_BRANDING_MODE
     // BRANDING MODE EASTER EGG - Check if encoder A button is pressed during startup
-    // Pin 4 (SWA) goes LOW when button is pressed
-    if (digitalRead(SWA) == LOW) {
-        activate_branding_mode();  // Never returns - infinite loop for photography
-    }
+    // Pin 4 (SWA) goes LOW when button is pressed. The banner is only queued,
+    // so play it out here, watching the button for as long as it is shown
+    bool banner_playing;
+    do {
+        banner_playing = display_task.step(millis());
+        if (digitalRead(SWA) == LOW) {
+            activate_branding_mode();  // Never returns - infinite loop for photography
+        }
+    } while (banner_playing);
 #endif
 
     unsigned long time = millis();
@@ -1102,9 +1159,11 @@ void loop()
 	set_application(APP_SIMRADIO, &display);
 
 	while(true){
+		PROFILE_BEGIN_PASS();
 		unsigned long time = millis();
 				// Update signal meter decay (capacitor-like discharge)
 		signal_meter.update(time);
+		LOOP_PHASE_END(LOOP_PHASE_SIGNAL_METER);
 		
 		// Update StationManager with current VFO frequency
 		// Only update when in VFO mode (dispatcher1)
@@ -1117,29 +1176,30 @@ void loop()
 				station_manager.updateStations(current_vfo->_frequency);
 			}
 		}
+		LOOP_PHASE_END(LOOP_PHASE_STATION_MANAGER);
 
 #ifdef CONFIG_TEST_PERFORMANCE
 		// Test station runs automatically - just listen to the audio output
 		// to determine loop performance and upper limits for station design
 #endif
 		// --- PANEL LOCK LED OVERRIDE ---
-        int lock_brightness = signal_meter.get_panel_led_brightness();
-        if (lock_brightness > 0) {
-            int pwm = (lock_brightness * PANEL_LOCK_LED_FULL_BRIGHTNESS) / (255 * PANEL_LED_BRIGHTNESS_DIVISOR);
-            analogWrite(WHITE_PANEL_LED, pwm); // White LED lock indicator
-        } else {
-            analogWrite(WHITE_PANEL_LED, 0);
-        }        // Comment out the old animation:
+        signal_meter.update_panel_led();
+		LOOP_PHASE_END(LOOP_PHASE_PANEL_LED);
 		realization_pool.step(time);
+		wave_gen_pool.flush();
+		LOOP_PHASE_END(LOOP_PHASE_REALIZATION_POOL);
 
 		// NOTE: Station step() calls are handled automatically by realization_pool.step()
 		// No need for manual step() calls - RealizationPool architecture handles this
 
 		encoder_handlerA.step();
 		encoder_handlerB.step();
+		LOOP_PHASE_END(LOOP_PHASE_ENCODERS);
 
-		// Step non-blocking title display if active
+		// Next frame of any scrolling text, then the title's pending updates
+		display_task.step(time);
 		dispatcher->step_title_display(&display);
+		LOOP_PHASE_END(LOOP_PHASE_TITLE_DISPLAY);
 
 		// check for changing dispatchers
 		bool pressed = encoder_handlerB.pressed();
@@ -1185,6 +1245,7 @@ void loop()
 				}
 				#endif
 				
+				TUNING_LATENCY_BEGIN(encoder_handlerA.detent_time());
 				dispatcher->dispatch_event(&display, ID_ENCODER_TUNING, encoder_handlerA.diff(), 0);
 				dispatcher->update_display(&display);
 				dispatcher->update_signal_meter(&signal_meter);
@@ -1193,6 +1254,8 @@ void loop()
 				// station_manager.updateStations(7000000);
 				
 				dispatcher->update_realization();
+				wave_gen_pool.flush();
+				TUNING_LATENCY_END();
 			}
 
 			if(encoderB_changed){
@@ -1211,5 +1274,13 @@ void loop()
 		if(pressed || long_pressed){
 			dispatcher->dispatch_event(&display, ID_ENCODER_TUNING, pressed, long_pressed);
 		}
+		LOOP_PHASE_END(LOOP_PHASE_DISPATCH);
+		PROFILE_END_PASS();
+
+		// Outside the timed pass so a dump doesn't show up as a slow loop
+#ifdef ENABLE_STACK_MONITOR
+		stack_monitor.step(time, &display);
+#endif
+		poll_diagnostics();
 	}
 }
@@ -1,6 +1,7 @@
 #include "mode.h"
 #include "mode_handler.h"
 #include "signal_meter.h"
+#include "displays.h"
 
 ModeHandler::ModeHandler(Mode *mode){
     set_mode(mode);    
@@ -29,19 +30,20 @@ bool ModeHandler::event_sink(bool pressed, bool long_pressed){
 
 
 void ModeHandler::show_title(HT16K33Disp *display){
-    display->scroll_string(_mode->_title);
+    // Queued; the display task scrolls it from the main loop
+    display_task.queue(_mode->_title);
     // update_display(display);
 }
 
 bool ModeHandler::begin_show_title(HT16K33Disp *display) {
-    // Start non-blocking scroll for the title
-    display->begin_scroll_string(_mode->_title);
+    // Queue the title behind anything already scrolling
+    display_task.queue(_mode->_title);
     return true;  // Title display is now active
 }
 
 bool ModeHandler::step_show_title(HT16K33Disp *display) {
-    // Continue the non-blocking scroll
-    return display->step_scroll_string(millis());
+    // The main loop steps the display task; the title is done when it is idle
+    return display_task.is_busy();
 }
 
 void ModeHandler::update_display(HT16K33Disp *display){
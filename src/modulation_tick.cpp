@@ -0,0 +1,191 @@
+#include "modulation_tick.h"
+#ifdef NATIVE_BUILD
+#include <native_host.h>
+#endif
+
+ModulationKeyer::ModulationKeyer(AsyncModulator *modulator)
+{
+    _modulator = modulator;
+#ifdef ENABLE_MODULATION_TICK
+    _output = NULL;
+    _held = false;
+    _complete = false;
+    _reported_on = false;
+    _next = _first;
+    _first = this;
+#endif
+}
+
+#ifndef ENABLE_MODULATION_TICK
+
+int ModulationKeyer::step(unsigned long time)
+{
+    return _modulator->step_modulator(time);
+}
+
+#else
+
+ModulationKeyer *ModulationKeyer::_first = NULL;
+bool ModulationKeyer::_running = false;
+
+int ModulationKeyer::step(unsigned long time)
+{
+    if (!_running) {
+        return _modulator->step_modulator(time);
+    }
+
+    noInterrupts();
+    bool on = _modulator->is_switched_on();
+    bool complete = _complete;
+    interrupts();
+
+    // An on/off change goes out before a completion that followed it
+    if (on != _reported_on) {
+        _reported_on = on;
+        return on ? STEP_TURN_ON : STEP_TURN_OFF;
+    }
+    if (complete) {
+        _complete = false;
+        return STEP_MESSAGE_COMPLETE;
+    }
+
+    // Nothing attached: tick() leaves the modulator to the main loop
+    if (!_output) {
+        int state = _modulator->step_modulator(time);
+        _reported_on = _modulator->is_switched_on();
+        return state;
+    }
+    return on ? STEP_LEAVE_ON : STEP_LEAVE_OFF;
+}
+
+void ModulationKeyer::set_output(WaveGen *wavegen)
+{
+    noInterrupts();
+    if (wavegen && wavegen != _output) {
+        wavegen->set_active_frequency(_modulator->is_switched_on());
+    }
+    _output = wavegen;
+    interrupts();
+}
+
+// A finished message no longer keys, so the station sets its own idle state
+bool ModulationKeyer::is_keying()
+{
+    return _running && _output && !_modulator->is_transmission_complete();
+}
+
+void ModulationKeyer::hold()
+{
+    _held = true;
+}
+
+void ModulationKeyer::release()
+{
+    // Starting a message resets the modulator; drop what the old one left
+    noInterrupts();
+    _complete = false;
+    _reported_on = _modulator->is_switched_on();
+    _held = false;
+    interrupts();
+}
+
+// Called from get_wake_time(), which RealizationPool runs with interrupts off
+bool ModulationKeyer::is_pending()
+{
+    return _complete || _modulator->is_switched_on() != _reported_on;
+}
+
+void ModulationKeyer::tick(unsigned long time)
+{
+    // Without a realized generator (none free, out of range, RTTY round
+    // break) the station is off the air and step() polls as without the tick
+    if (_held || !_output || time < _modulator->get_next_event_time()) {
+        return;
+    }
+
+    bool was_complete = _modulator->is_transmission_complete();
+    switch (_modulator->step_modulator(time)) {
+        case STEP_TURN_ON:
+            if (_output) _output->key(true);
+            break;
+        case STEP_TURN_OFF:
+            if (_output) _output->key(false);
+            break;
+    }
+    // Morse reports completion as a step code, RTTY only through
+    // is_transmission_complete(); latch both the same way
+    if (!was_complete && _modulator->is_transmission_complete()) {
+        _complete = true;
+    }
+}
+
+void ModulationKeyer::service()
+{
+    unsigned long time = millis();
+    for (ModulationKeyer *keyer = _first; keyer; keyer = keyer->_next) {
+        keyer->tick(time);
+    }
+}
+
+// ========================================
+// TICK SOURCE
+// ========================================
+#if defined(__AVR_ATmega328P__)
+
+void ModulationKeyer::begin()
+{
+    noInterrupts();
+    TCCR2A = (1 << WGM21);              // CTC
+    TCCR2B = (1 << CS22);               // clk/64: 250 kHz
+    OCR2A = (F_CPU / 64 / (1000000UL / MODULATION_TICK_US)) - 1;
+    TCNT2 = 0;
+    TIMSK2 = (1 << OCIE2A);
+    _running = true;
+    interrupts();
+}
+
+ISR(TIMER2_COMPA_vect)
+{
+    ModulationKeyer::service();
+}
+
+#elif defined(__AVR_ATmega4809__)
+
+#define TICK_TCB_CAT(a, b, c) a##b##c
+#define TICK_TCB_NAME(n, suffix) TICK_TCB_CAT(TCB, n, suffix)
+#define TICK_TCB TICK_TCB_NAME(MODULATION_TICK_TCB, )
+#define TICK_TCB_VECT TICK_TCB_NAME(MODULATION_TICK_TCB, _INT_vect)
+
+void ModulationKeyer::begin()
+{
+    noInterrupts();
+    TICK_TCB.CTRLA = 0;
+    TICK_TCB.CTRLB = TCB_CNTMODE_INT_gc;    // periodic interrupt
+    TICK_TCB.CCMP = (F_CPU / 2 / (1000000UL / MODULATION_TICK_US)) - 1;
+    TICK_TCB.CNT = 0;
+    TICK_TCB.INTFLAGS = TCB_CAPT_bm;
+    TICK_TCB.INTCTRL = TCB_CAPT_bm;
+    TICK_TCB.CTRLA = TCB_CLKSEL_CLKDIV2_gc | TCB_ENABLE_bm;
+    _running = true;
+    interrupts();
+}
+
+ISR(TICK_TCB_VECT)
+{
+    TICK_TCB.INTFLAGS = TCB_CAPT_bm;
+    ModulationKeyer::service();
+}
+
+#elif defined(NATIVE_BUILD)
+
+void ModulationKeyer::begin()
+{
+    native_attach_tick(ModulationKeyer::service, MODULATION_TICK_US);
+    _running = true;
+}
+
+#else
+#error "ENABLE_MODULATION_TICK: no tick source for this board"
+#endif
+
+#endif // ENABLE_MODULATION_TICK
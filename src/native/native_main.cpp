@@ -0,0 +1,163 @@
+// ============================================================================
+// NATIVE HOST ENTRY POINT
+// ============================================================================
+// Builds the station stack on a Linux host (pio run -e native) and runs it
+// against the virtual clock for a while, printing where every station ended up.
+// This is the smoke test for the Arduino shim in lib/ArduinoShim: one of each
+// station type shares the four wave generators, exactly as in main.cpp.
+//
+// USAGE:
+//   .pio/build/native/program [seconds] [seed]
+
+#include <Arduino.h>
+#include <MD_AD9833.h>
+
+#include "signal_meter.h"
+#include "station_manager.h"
+#include "realization_pool.h"
+#include "wave_gen_pool.h"
+#include "wavegen.h"
+#include "vfo.h"
+
+#include "sim_station.h"
+#include "sim_numbers.h"
+#include "sim_rtty.h"
+#include "sim_pager.h"
+#include "sim_pager2.h"
+#include "sim_jammer.h"
+#include "sim_test.h"
+
+#define DEFAULT_RUN_SECONDS 60
+#define DEFAULT_SEED 1
+
+// Same wiring as main.cpp
+const byte PIN_DATA = 11;
+const byte PIN_CLK = 13;
+const byte PIN_FSYNC1 = 8;
+const byte PIN_FSYNC2 = 14;
+const byte PIN_FSYNC3 = 15;
+const byte PIN_FSYNC4 = 16;
+
+// Host mock in place of main.cpp's hardware SPI
+AD9833MockSPI ad9833_bus;
+
+MD_AD9833 AD1(&ad9833_bus, PIN_FSYNC1);
+MD_AD9833 AD2(&ad9833_bus, PIN_FSYNC2);
+MD_AD9833 AD3(&ad9833_bus, PIN_FSYNC3);
+MD_AD9833 AD4(&ad9833_bus, PIN_FSYNC4);
+
+WaveGen wavegen1(&AD1);
+WaveGen wavegen2(&AD2);
+WaveGen wavegen3(&AD3);
+WaveGen wavegen4(&AD4);
+
+WaveGen *wavegens[4] = {&wavegen1, &wavegen2, &wavegen3, &wavegen4};
+bool realizer_stats[4] = {false, false, false, false};
+WaveGenPool wave_gen_pool(wavegens, realizer_stats, 4);
+
+// Referenced by Flashlight (normally defined in main.cpp)
+SignalMeter signal_meter;
+
+// One of each station type, clustered around VFO A
+SimStation cw_station(&wave_gen_pool, &signal_meter, 7001000.0, 18, 40);
+SimNumbers numbers_station(&wave_gen_pool, &signal_meter, 7002000.0, 15);
+SimRTTY rtty_station(&wave_gen_pool, &signal_meter, 7003000.0);
+SimPager pager_station(&wave_gen_pool, &signal_meter, 7004000.0);
+SimPager2 pager2_station(&wave_gen_pool, &signal_meter, 7005000.0);
+SimJammer jammer_station(&wave_gen_pool);
+SimTest test_station(&wave_gen_pool, &signal_meter, 7006000.0);
+
+#define NUM_STATIONS 7
+
+SimTransmitter *station_pool[NUM_STATIONS] = {
+    &cw_station, &numbers_station, &rtty_station, &pager_station,
+    &pager2_station, &jammer_station, &test_station
+};
+
+Realization *realizations[NUM_STATIONS] = {
+    &cw_station, &numbers_station, &rtty_station, &pager_station,
+    &pager2_station, &jammer_station, &test_station
+};
+
+const char *station_names[NUM_STATIONS] = {
+    "SimStation", "SimNumbers", "SimRTTY", "SimPager", "SimPager2", "SimJammer", "SimTest"
+};
+
+bool realization_stats[NUM_STATIONS] = {false, false, false, false, false, false, false};
+RealizationPool realization_pool(realizations, realization_stats, NUM_STATIONS);
+StationManager station_manager(station_pool, NUM_STATIONS);
+
+VFO vfoa("VFO A", 7000000.0, 10, &realization_pool);
+
+const char *state_name(StationState state){
+    switch(state){
+        case DORMANT: return "DORMANT";
+        case ACTIVE:  return "ACTIVE";
+        case AUDIBLE: return "AUDIBLE";
+        case SILENT:  return "SILENT";
+    }
+    return "?";
+}
+
+int main(int argc, char **argv){
+    unsigned long run_seconds = argc > 1 ? strtoul(argv[1], NULL, 10) : DEFAULT_RUN_SECONDS;
+    unsigned long seed = argc > 2 ? strtoul(argv[2], NULL, 10) : DEFAULT_SEED;
+    randomSeed(seed);
+
+    signal_meter.init();
+
+    AD1.begin();
+    AD2.begin();
+    AD3.begin();
+    AD4.begin();
+
+    station_manager.enableDynamicPipelining(true);
+    station_manager.setupPipeline(vfoa._frequency);
+    jammer_station.begin(millis(), 7006500.0);
+
+    vfoa.update_realization();
+
+    unsigned long end_time = run_seconds * 1000;
+    unsigned long steps = 0;
+    while(millis() < end_time){
+        unsigned long time = millis();
+        signal_meter.update(time);
+        station_manager.updateStations(vfoa._frequency);
+        realization_pool.step(time);
+        wave_gen_pool.flush();
+        steps++;
+        native_advance_millis(1);
+    }
+
+    Serial.print("Ran ");
+    Serial.print(run_seconds);
+    Serial.print(" s (");
+    Serial.print(steps);
+    Serial.print(" loop passes), seed ");
+    Serial.println(seed);
+
+    for(int i = 0; i < NUM_STATIONS; i++){
+        Serial.print(station_names[i]);
+        Serial.print(" @ ");
+        Serial.print((unsigned long)station_pool[i]->get_fixed_frequency());
+        Serial.print(" Hz  ");
+        Serial.print(state_name(station_pool[i]->get_station_state()));
+        Serial.print("  realizer ");
+        Serial.println(realizations[i]->_realizer);
+    }
+
+    Serial.print("Free wave generators: ");
+    Serial.print(wave_gen_pool.get_available_count());
+    Serial.print(" of ");
+    Serial.println(wave_gen_pool.get_total_count());
+    Serial.print("AD9833 FSYNC writes (chip 1-4): ");
+    Serial.print(native_get_pin_write_count(PIN_FSYNC1) / 2);
+    Serial.print(" ");
+    Serial.print(native_get_pin_write_count(PIN_FSYNC2) / 2);
+    Serial.print(" ");
+    Serial.print(native_get_pin_write_count(PIN_FSYNC3) / 2);
+    Serial.print(" ");
+    Serial.println(native_get_pin_write_count(PIN_FSYNC4) / 2);
+
+    return 0;
+}
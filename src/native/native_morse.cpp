@@ -0,0 +1,360 @@
+// ============================================================================
+// ASYNCMORSE CONFORMANCE AND BENCHMARK
+// ============================================================================
+// Keys messages through AsyncMorse against the virtual clock, the way
+// SimStation does (STEPS_PER_MS step_modulator() calls per millisecond), and
+// measures every key-down and key-up interval.
+//
+// Conformance, 5 to 60 WPM:
+//   - the element sequence matches an independent Morse table (A-Z, 0-9)
+//   - dot 1, dash 3, inter-element 1, inter-character 3 and word 7 units,
+//     measured in the modulator's own unit (MORSE_TIME_FROM_WPM)
+//   - the unit against PARIS (1200/wpm ms): MORSE_TIME_FROM_WPM is 1000/wpm,
+//     so stations key about 20% faster than their nominal speed; reported as
+//     the effective WPM rather than failed
+//
+// Fist quality: spread of each interval class against its nominal length for
+// a range of set_fist_quality() values (compute_element_time() variation).
+//
+// Benchmark: host nanoseconds per step_modulator() call and per keyed element.
+// Host timings only rank changes against each other; they are not AVR cycles.
+//
+// Exits non-zero if any conformance check fails.
+//
+// USAGE:
+//   pio run -e native_morse && .pio/build/native_morse/program [seed]
+
+#include <Arduino.h>
+#include <math.h>
+#include <time.h>
+#include "async_morse.h"
+
+#define DEFAULT_MORSE_SEED 1
+
+// SimStation steps its modulator once per loop pass; several passes per ms
+#define STEPS_PER_MS 4
+
+// Measured intervals may differ from nominal by the 1 ms stepping resolution
+#define TIMING_TOLERANCE_MS 1
+
+#define PARIS_UNITS 50              // "PARIS " is 50 units including the word gap
+#define PARIS_MS_FROM_WPM(w) (1200.0 / (w))
+
+#define MAX_INTERVALS 2048
+
+#define CONFORMANCE_TEXT "PARIS PARIS"
+#define COVERAGE_TEXT "THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG 0123456789"
+#define FIST_TEXT "CQ CQ DE K6JH K6JH K"
+#define FIST_REPEATS 40
+#define BENCHMARK_REPEATS 200
+
+const int test_wpms[] = {5, 8, 10, 13, 15, 18, 20, 22, 25, 30, 35, 40, 45, 50, 55, 60};
+const byte test_fists[] = {0, 32, 64, 85, 128, 170, 200, 255};
+
+// Reference Morse, independent of the firmware's bit-packed table
+const char *const reference_letters[26] = {
+    ".-", "-...", "-.-.", "-..", ".", "..-.", "--.", "....", "..", ".---",
+    "-.-", ".-..", "--", "-.", "---", ".--.", "--.-", ".-.", "...", "-",
+    "..-", "...-", ".--", "-..-", "-.--", "--.."
+};
+const char *const reference_digits[10] = {
+    "-----", ".----", "..---", "...--", "....-", ".....", "-....", "--...", "---..", "----."
+};
+
+// Interval classes, in units
+enum IntervalClass { DOT, DASH, ELEMENT_GAP, CHAR_GAP, WORD_GAP, NUM_CLASSES };
+const char *const class_names[NUM_CLASSES] = {"dot", "dash", "element gap", "char gap", "word gap"};
+const int class_units[NUM_CLASSES] = {1, 3, 1, 3, 7};
+
+struct Interval {
+    bool on;
+    unsigned long length;   // ms
+};
+
+static Interval intervals[MAX_INTERVALS];
+static int interval_count;
+static int expected[MAX_INTERVALS];    // IntervalClass per interval
+static int expected_count;
+static unsigned long step_calls;
+
+static int failures;
+
+// ========================================
+// KEYING
+// ========================================
+// key a message, recording on and off intervals; returns the time of the last key-up
+unsigned long key_message(AsyncMorse *morse, const char *text, int wpm){
+    interval_count = 0;
+    morse->start_transmission(text, wpm);
+
+    unsigned long time = 0;
+    unsigned long edge = 0;
+    bool on = false;
+    bool complete = false;
+
+    while(!complete){
+        for(int i = 0; i < STEPS_PER_MS && !complete; i++){
+            step_calls++;
+            int state = morse->step_modulator(time);
+            if(state == STEP_MORSE_MESSAGE_COMPLETE){
+                complete = true;
+            } else if(state == STEP_MORSE_TURN_ON || state == STEP_MORSE_TURN_OFF){
+                if(time > edge && interval_count < MAX_INTERVALS){
+                    intervals[interval_count].on = on;
+                    intervals[interval_count].length = time - edge;
+                    interval_count++;
+                }
+                edge = time;
+                on = state == STEP_MORSE_TURN_ON;
+            }
+        }
+        time++;
+    }
+    return edge;
+}
+
+// the interval classes a correct keyer produces for text, up to the last key-up
+void build_expected(const char *text){
+    expected_count = 0;
+    bool pending_gap = false;
+    int gap = CHAR_GAP;
+
+    for(const char *c = text; *c; c++){
+        if(*c == ' '){
+            gap = WORD_GAP;
+            continue;
+        }
+        const char *code = NULL;
+        if(*c >= 'A' && *c <= 'Z')
+            code = reference_letters[*c - 'A'];
+        else if(*c >= '0' && *c <= '9')
+            code = reference_digits[*c - '0'];
+        if(!code)
+            continue;
+
+        if(pending_gap)
+            expected[expected_count++] = gap;
+        for(const char *e = code; *e; e++){
+            if(e != code)
+                expected[expected_count++] = ELEMENT_GAP;
+            expected[expected_count++] = *e == '-' ? DASH : DOT;
+        }
+        pending_gap = true;
+        gap = CHAR_GAP;
+    }
+}
+
+void check(bool ok, const char *what, int wpm){
+    if(ok)
+        return;
+    failures++;
+    Serial.print("FAIL ");
+    Serial.print(wpm);
+    Serial.print(" WPM: ");
+    Serial.println(what);
+}
+
+// ========================================
+// CONFORMANCE
+// ========================================
+// intervals must follow the reference sequence
+bool check_sequence(int wpm){
+    // the first key-down starts at time 0, so intervals begin with an "on"
+    if(interval_count != expected_count){
+        Serial.print("  got ");
+        Serial.print(interval_count);
+        Serial.print(" intervals, expected ");
+        Serial.println(expected_count);
+        return false;
+    }
+    for(int i = 0; i < interval_count; i++){
+        bool expect_on = expected[i] == DOT || expected[i] == DASH;
+        if(intervals[i].on != expect_on)
+            return false;
+    }
+    (void)wpm;
+    return true;
+}
+
+void run_conformance(){
+    AsyncMorse morse;
+
+    Serial.println("Conformance (\"" CONFORMANCE_TEXT "\"), mean length in modulator units / PARIS units:");
+    Serial.println("wpm  unit-ms  dot          dash         el-gap       char-gap     word-gap     eff-wpm");
+
+    for(unsigned int w = 0; w < sizeof(test_wpms) / sizeof(test_wpms[0]); w++){
+        int wpm = test_wpms[w];
+        double unit = MORSE_TIME_FROM_WPM(wpm);
+        double paris_unit = PARIS_MS_FROM_WPM(wpm);
+
+        build_expected(COVERAGE_TEXT);
+        key_message(&morse, COVERAGE_TEXT, wpm);
+        check(check_sequence(wpm), "element sequence differs from the reference table", wpm);
+
+        build_expected(CONFORMANCE_TEXT);
+        unsigned long total = key_message(&morse, CONFORMANCE_TEXT, wpm);
+        bool sequence_ok = check_sequence(wpm);
+        check(sequence_ok, "PARIS element sequence", wpm);
+
+        double sum[NUM_CLASSES] = {0};
+        int count[NUM_CLASSES] = {0};
+        long worst[NUM_CLASSES] = {0};     // largest error in ms
+        if(sequence_ok){
+            for(int i = 0; i < interval_count; i++){
+                int c = expected[i];
+                sum[c] += intervals[i].length;
+                count[c]++;
+                long error = (long)intervals[i].length - (long)(class_units[c] * (int)unit);
+                if(labs(error) > labs(worst[c]))
+                    worst[c] = error;
+            }
+        }
+
+        Serial.print(wpm);
+        Serial.print("\t");
+        Serial.print(unit, 0);
+        for(int c = 0; c < NUM_CLASSES; c++){
+            double mean = count[c] ? sum[c] / count[c] : 0.0;
+            Serial.print("\t");
+            Serial.print(mean / unit, 2);
+            Serial.print("/");
+            Serial.print(mean / paris_unit, 2);
+        }
+        // "PARIS PARIS" up to the last key-up is two words of 50 units less the word gap
+        double measured_paris_ms = (double)total / (2 * PARIS_UNITS - class_units[WORD_GAP]) * PARIS_UNITS;
+        Serial.print("\t");
+        Serial.println(60000.0 / measured_paris_ms, 1);
+
+        for(int c = 0; c < NUM_CLASSES; c++){
+            if(labs(worst[c]) <= TIMING_TOLERANCE_MS)
+                continue;
+            char what[64];
+            snprintf(what, sizeof(what), "%s off by %ld ms (%d units expected)",
+                     class_names[c], worst[c], class_units[c]);
+            check(false, what, wpm);
+        }
+    }
+    Serial.println();
+}
+
+// ========================================
+// FIST QUALITY
+// ========================================
+void run_fist_quality(){
+    AsyncMorse morse;
+    const int wpm = 20;
+    double unit = MORSE_TIME_FROM_WPM(wpm);
+
+    Serial.print("Fist quality at ");
+    Serial.print(wpm);
+    Serial.println(" WPM, interval length as % of nominal: mean sd [min..max]");
+    Serial.println("fist  dot                   dash                  el-gap                char-gap              word-gap");
+
+    build_expected(FIST_TEXT);
+    for(unsigned int f = 0; f < sizeof(test_fists); f++){
+        morse.set_fist_quality(test_fists[f]);
+
+        double sum[NUM_CLASSES] = {0}, sum_sq[NUM_CLASSES] = {0};
+        double lo[NUM_CLASSES], hi[NUM_CLASSES];
+        int count[NUM_CLASSES] = {0};
+        for(int c = 0; c < NUM_CLASSES; c++){
+            lo[c] = 1e9;
+            hi[c] = 0.0;
+        }
+
+        for(int r = 0; r < FIST_REPEATS; r++){
+            key_message(&morse, FIST_TEXT, wpm);
+            if(!check_sequence(wpm)){
+                check(false, "fist quality changed the element sequence", wpm);
+                break;
+            }
+            for(int i = 0; i < interval_count; i++){
+                int c = expected[i];
+                double percent = 100.0 * intervals[i].length / (class_units[c] * unit);
+                sum[c] += percent;
+                sum_sq[c] += percent * percent;
+                count[c]++;
+                if(percent < lo[c]) lo[c] = percent;
+                if(percent > hi[c]) hi[c] = percent;
+            }
+        }
+
+        Serial.print(test_fists[f]);
+        for(int c = 0; c < NUM_CLASSES; c++){
+            double mean = count[c] ? sum[c] / count[c] : 0.0;
+            double variance = count[c] ? sum_sq[c] / count[c] - mean * mean : 0.0;
+            Serial.print("\t");
+            Serial.print(mean, 1);
+            Serial.print(" ");
+            Serial.print(variance > 0.0 ? sqrt(variance) : 0.0, 2);
+            Serial.print(" [");
+            Serial.print(count[c] ? lo[c] : 0.0, 1);
+            Serial.print("..");
+            Serial.print(hi[c], 1);
+            Serial.print("]");
+        }
+        Serial.println();
+    }
+    Serial.println();
+}
+
+// ========================================
+// BENCHMARK
+// ========================================
+double wall_ns(){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+void run_benchmark(){
+    AsyncMorse morse;
+
+    Serial.println("Benchmark (\"" COVERAGE_TEXT "\"):");
+    Serial.println("wpm  calls/msg  ns/call  elements/msg  ns/element");
+
+    const int bench_wpms[] = {5, 20, 60};
+    for(unsigned int w = 0; w < sizeof(bench_wpms) / sizeof(bench_wpms[0]); w++){
+        int wpm = bench_wpms[w];
+        unsigned long elements = 0;
+        step_calls = 0;
+
+        double start = wall_ns();
+        for(int r = 0; r < BENCHMARK_REPEATS; r++){
+            key_message(&morse, COVERAGE_TEXT, wpm);
+            elements += (interval_count + 1) / 2;
+        }
+        double elapsed = wall_ns() - start;
+
+        Serial.print(wpm);
+        Serial.print("\t");
+        Serial.print(step_calls / BENCHMARK_REPEATS);
+        Serial.print("\t");
+        Serial.print(elapsed / step_calls, 1);
+        Serial.print("\t");
+        Serial.print(elements / BENCHMARK_REPEATS);
+        Serial.print("\t\t");
+        Serial.println(elapsed / elements, 0);
+    }
+    Serial.println();
+}
+
+// ========================================
+// MAIN
+// ========================================
+int main(int argc, char **argv){
+    unsigned long seed = argc > 1 ? strtoul(argv[1], NULL, 10) : DEFAULT_MORSE_SEED;
+    randomSeed(seed);
+
+    run_conformance();
+    run_fist_quality();
+    run_benchmark();
+
+    if(failures){
+        Serial.print(failures);
+        Serial.println(" conformance failures");
+        return 1;
+    }
+    Serial.println("All conformance checks passed");
+    return 0;
+}
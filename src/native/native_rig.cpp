@@ -0,0 +1,212 @@
+#include <Arduino.h>
+#include <HT16K33Twi.h>
+#include <time.h>
+#include "native_rig.h"
+#include "displays.h"
+#include "hardware.h"
+#include "wavegen.h"
+#include "vfo_tuner.h"
+#include "sim_station.h"
+#include "sim_numbers.h"
+#include "sim_rtty.h"
+#include "sim_pager.h"
+#include "modulation_tick.h"
+#include "input_capture.h"
+#ifdef MD_AD9833_RECORDING
+#include <MD_AD9833_Recorder.h>
+#endif
+
+// ========================================
+// HARDWARE
+// ========================================
+AD9833MockSPI rig_ad9833_bus;
+MD_AD9833 AD1(&rig_ad9833_bus, RIG_PIN_FSYNC1);
+MD_AD9833 AD2(&rig_ad9833_bus, RIG_PIN_FSYNC2);
+MD_AD9833 AD3(&rig_ad9833_bus, RIG_PIN_FSYNC3);
+MD_AD9833 AD4(&rig_ad9833_bus, RIG_PIN_FSYNC4);
+MD_AD9833 *rig_ad9833s[RIG_NUM_WAVEGENS] = {&AD1, &AD2, &AD3, &AD4};
+
+WaveGen wavegen1(&AD1);
+WaveGen wavegen2(&AD2);
+WaveGen wavegen3(&AD3);
+WaveGen wavegen4(&AD4);
+
+WaveGen *wavegens[RIG_NUM_WAVEGENS] = {&wavegen1, &wavegen2, &wavegen3, &wavegen4};
+bool rig_wavegen_stats[RIG_NUM_WAVEGENS] = {false, false, false, false};
+WaveGenPool wave_gen_pool(wavegens, rig_wavegen_stats, RIG_NUM_WAVEGENS);
+
+SignalMeter signal_meter;
+
+EncoderHandler encoder_handlerA(0, RIG_CLKA, RIG_DTA, RIG_SWA, RIG_PULSES_PER_DETENT);
+EncoderHandler encoder_handlerB(1, RIG_CLKB, RIG_DTB, RIG_SWB, RIG_PULSES_PER_DETENT);
+
+// ========================================
+// STATIONS (CONFIG_TEN_CW)
+// ========================================
+SimStation cw_station1(&wave_gen_pool, &signal_meter, 7001000.0, 31, 10);
+SimStation cw_station2(&wave_gen_pool, &signal_meter, 7001500.0, 19, 50);
+SimStation cw_station3(&wave_gen_pool, &signal_meter, 7002000.0, 11, 95);
+SimStation cw_station4(&wave_gen_pool, &signal_meter, 7002500.0, 15, 40);
+SimStation cw_station5(&wave_gen_pool, &signal_meter, 7003000.0, 25, 80);
+SimStation cw_station6(&wave_gen_pool, &signal_meter, 7003500.0, 22, 30);
+SimStation cw_station7(&wave_gen_pool, &signal_meter, 7004000.0, 18, 60);
+SimStation cw_station8(&wave_gen_pool, &signal_meter, 7004500.0, 28, 20);
+SimStation cw_station9(&wave_gen_pool, &signal_meter, 7005000.0, 13, 70);
+SimStation cw_station10(&wave_gen_pool, &signal_meter, 7005500.0, 16, 45);
+
+SimNumbers numbers_station1(&wave_gen_pool, &signal_meter, 7006000.0, 12);
+SimNumbers numbers_station2(&wave_gen_pool, &signal_meter, 7007000.0, 15);
+SimNumbers numbers_station3(&wave_gen_pool, &signal_meter, 7008000.0, 18);
+SimNumbers numbers_station4(&wave_gen_pool, &signal_meter, 7009000.0, 22);
+SimNumbers numbers_station5(&wave_gen_pool, &signal_meter, 7010000.0, 10);
+
+SimRTTY rtty_station1(&wave_gen_pool, &signal_meter, 14002000.0);
+SimRTTY rtty_station2(&wave_gen_pool, &signal_meter, 14004000.0);
+SimRTTY rtty_station3(&wave_gen_pool, &signal_meter, 14006000.0);
+SimRTTY rtty_station4(&wave_gen_pool, &signal_meter, 14008000.0);
+
+SimPager pager_station1(&wave_gen_pool, &signal_meter, 146800000.0);
+SimPager pager_station2(&wave_gen_pool, &signal_meter, 146900000.0);
+
+SimTransmitter *station_pool[RIG_NUM_STATIONS] = {
+    &cw_station1, &cw_station2, &cw_station3, &cw_station4, &cw_station5,
+    &cw_station6, &cw_station7, &cw_station8, &cw_station9, &cw_station10,
+    &numbers_station1, &numbers_station2, &numbers_station3, &numbers_station4, &numbers_station5,
+    &rtty_station1, &rtty_station2, &rtty_station3, &rtty_station4,
+    &pager_station1, &pager_station2
+};
+
+Realization *realizations[RIG_NUM_STATIONS] = {
+    &cw_station1, &cw_station2, &cw_station3, &cw_station4, &cw_station5,
+    &cw_station6, &cw_station7, &cw_station8, &cw_station9, &cw_station10,
+    &numbers_station1, &numbers_station2, &numbers_station3, &numbers_station4, &numbers_station5,
+    &rtty_station1, &rtty_station2, &rtty_station3, &rtty_station4,
+    &pager_station1, &pager_station2
+};
+
+bool realization_stats[RIG_NUM_STATIONS];
+RealizationPool realization_pool(realizations, realization_stats, RIG_NUM_STATIONS);
+StationManager station_manager(station_pool, RIG_NUM_STATIONS);
+
+// ========================================
+// SIMRADIO APPLICATION
+// ========================================
+VFO vfoa("VFO A", RIG_START_FREQUENCY, 10, &realization_pool);
+VFO_Tuner tunera(&vfoa);
+ModeHandler *rig_handlers[1] = {&tunera};
+EventDispatcher rig_dispatcher(rig_handlers, 1);
+
+void rig_setup(){
+#ifdef MD_AD9833_RECORDING
+    ad9833_recorder.set_owner_resolver(rig_chip_owner);
+#endif
+    HT16K33Twi::begin();
+    signal_meter.init();
+
+    MD_AD9833::beginAll(rig_ad9833s, RIG_NUM_WAVEGENS, WaveGen::tuning_word(0.1));
+
+    station_manager.enableDynamicPipelining(true);
+    station_manager.setupPipeline(RIG_START_FREQUENCY);
+
+    // The tools' trajectories and band edges count detents of vfoa._step
+    tunera.set_acceleration(false);
+
+#ifdef ENABLE_MODULATION_TICK
+    ModulationKeyer::begin();
+#endif
+#ifdef ENABLE_INPUT_CAPTURE
+    native_set_encoder_pins(RIG_CLKA, RIG_DTA);
+    native_set_encoder_pins(RIG_CLKB, RIG_DTB);
+    InputCapture::begin();
+#endif
+}
+
+void rig_start_stations(){
+    unsigned long time = millis();
+
+    // Staggered like loop(): station n starts within n seconds
+    for(int i = 0; i < RIG_NUM_STATIONS; i++){
+        station_pool[i]->begin(time + random((i + 1) * 1000L));
+        station_pool[i]->set_station_state(AUDIBLE);
+    }
+
+    // set_application(APP_SIMRADIO) without the title scroll
+    rig_dispatcher.set_mode(0);
+    rig_dispatcher.update_realization();
+
+    // purge_events(): the handlers report a spurious turn on their first step
+    encoder_handlerA.step();
+    encoder_handlerB.step();
+    while(encoder_handlerA.changed() || encoder_handlerB.changed()){
+        encoder_handlerA.diff();
+        encoder_handlerB.diff();
+    }
+}
+
+double rig_update_stations_ns = 0.0;
+
+static double rig_wall_ns(){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+bool rig_loop_pass(unsigned long time){
+    signal_meter.update(time);
+
+    double start = rig_wall_ns();
+    station_manager.updateStations(vfoa._frequency);
+    rig_update_stations_ns = rig_wall_ns() - start;
+
+    signal_meter.update_panel_led();
+
+    realization_pool.step(time);
+    wave_gen_pool.flush();
+
+    encoder_handlerA.step();
+    encoder_handlerB.step();
+
+    if(!encoder_handlerA.changed())
+        return false;
+
+    rig_dispatcher.dispatch_event(&display, ID_ENCODER_TUNING, encoder_handlerA.diff(), 0);
+    rig_dispatcher.update_display(&display);
+    rig_dispatcher.update_signal_meter(&signal_meter);
+    rig_dispatcher.update_realization();
+    wave_gen_pool.flush();
+    return true;
+}
+
+unsigned long rig_next_event_time(unsigned long time){
+    unsigned long next_event = realization_pool.get_next_event_time(time);
+    unsigned long pipeline_event = station_manager.getNextEventTime();
+    return pipeline_event < next_event ? pipeline_event : next_event;
+}
+
+void rig_turn_tuning(int detents){
+    native_turn_encoder(RIG_CLKA, (long)detents * RIG_PULSES_PER_DETENT);
+}
+
+const char *rig_station_type(int station){
+    if(station < 10)
+        return "CW";
+    if(station < 15)
+        return "Numbers";
+    if(station < 19)
+        return "RTTY";
+    return "Pager";
+}
+
+#ifdef MD_AD9833_RECORDING
+uint8_t rig_chip_owner(uint8_t chip){
+    for(int i = 0; i < RIG_NUM_STATIONS; i++){
+        if(station_pool[i]->_realizer == chip)
+            return i;
+    }
+    return AD9833_NO_OWNER;
+}
+
+const char *rig_owner_name(uint8_t owner){
+    return rig_station_type(owner);
+}
+#endif
@@ -0,0 +1,86 @@
+#ifndef __NATIVE_RIG_H__
+#define __NATIVE_RIG_H__
+
+// ============================================================================
+// HOST RIG
+// ============================================================================
+// The CONFIG_TEN_CW line-up from main.cpp (21 stations sharing 4 wave
+// generators) wired to the host stand-ins in lib/ArduinoShim, plus the slice
+// of loop() that drives it. Shared by the host tools in src/native/ so they
+// all exercise the same station mix as the firmware.
+
+#include <Arduino.h>
+#include <MD_AD9833.h>
+#include <Encoder.h>
+#include "signal_meter.h"
+#include "station_manager.h"
+#include "realization_pool.h"
+#include "wave_gen_pool.h"
+#include "encoder_handler.h"
+#include "event_dispatcher.h"
+#include "vfo.h"
+
+#define RIG_NUM_STATIONS 21
+#define RIG_NUM_WAVEGENS 4
+
+// Same pins as main.cpp
+#define RIG_CLKA 3
+#define RIG_DTA 2
+#define RIG_SWA 4
+#define RIG_CLKB 6
+#define RIG_DTB 5
+#define RIG_SWB 7
+#define RIG_PULSES_PER_DETENT 2
+
+#define RIG_PIN_DATA 11
+#define RIG_PIN_CLK 13
+#define RIG_PIN_FSYNC1 8
+#define RIG_PIN_FSYNC2 14
+#define RIG_PIN_FSYNC3 15
+#define RIG_PIN_FSYNC4 16
+
+#define RIG_START_FREQUENCY 7000000
+
+extern MD_AD9833 *rig_ad9833s[RIG_NUM_WAVEGENS];
+extern bool rig_wavegen_stats[RIG_NUM_WAVEGENS];   // true while a station holds the generator
+extern WaveGenPool wave_gen_pool;
+extern SignalMeter signal_meter;
+
+extern SimTransmitter *station_pool[RIG_NUM_STATIONS];
+extern RealizationPool realization_pool;
+extern StationManager station_manager;
+extern VFO vfoa;
+extern EventDispatcher rig_dispatcher;
+extern EncoderHandler encoder_handlerA;
+extern EncoderHandler encoder_handlerB;
+
+// host time spent in station_manager.updateStations() by the last rig_loop_pass()
+extern double rig_update_stations_ns;
+
+// setup() equivalent: generators, signal meter and the dynamic pipeline
+void rig_setup();
+
+// the station start-up at the top of loop()
+void rig_start_stations();
+
+// one pass of the loop() body at the current virtual time
+// returns true if the tuning encoder moved the VFO
+bool rig_loop_pass(unsigned long time);
+
+// earliest time a loop pass has work to do: station events and pipeline settle time
+unsigned long rig_next_event_time(unsigned long time);
+
+// queue tuning encoder detents (positive is clockwise), read on the next pass
+void rig_turn_tuning(int detents);
+
+// short station type label for reports, e.g. "CW"
+const char *rig_station_type(int station);
+
+#ifdef MD_AD9833_RECORDING
+// Recorder owner tags are station indexes: attribute each AD9833 write to the
+// station holding that generator at the time, labelled by station type
+uint8_t rig_chip_owner(uint8_t chip);
+const char *rig_owner_name(uint8_t owner);
+#endif
+
+#endif // __NATIVE_RIG_H__
@@ -0,0 +1,342 @@
+// ============================================================================
+// DISCRETE-EVENT BAND SIMULATOR
+// ============================================================================
+// Runs the loop() body from main.cpp (see native_rig.cpp) against the virtual
+// clock, jumping straight to the next time anything has work to do instead of
+// spinning: the earliest station event (Morse/RTTY element, pager tone, CQ or
+// group wait deadline), the pipeline settle time, or the next knob movement of
+// a simulated operator. A day of band activity runs in seconds.
+//
+// Reports, per simulated hour and in total:
+//   - wave generator occupancy (time-weighted)
+//   - relocation churn: stations moved by the dynamic pipeline
+//   - generator handoffs: acquisitions of a free generator by a station
+//   - AD9833 register writes per second, by chip and by owning station type
+//
+// The signal meter receives one charge pulse per pass instead of one per
+// hardware loop, so meter levels are not meaningful here.
+//
+// USAGE:
+//   pio run -e native_sim && .pio/build/native_sim/program [hours] [seed] [tuning]
+//   tuning: 1 = simulated operator turns the VFO knob (default), 0 = VFO parked
+
+#include <Arduino.h>
+#include <time.h>
+#include <MD_AD9833_Recorder.h>
+#include "native_rig.h"
+
+#define DEFAULT_SIM_HOURS 24
+#define DEFAULT_SIM_SEED 1
+
+#define MS_PER_HOUR 3600000UL
+
+// Cap on back-to-back passes at the same millisecond before forcing the
+// clock forward, in case something reports an event it never consumes
+#define MAX_PASSES_PER_MS 8
+
+// Simulated operator: listen for a while, then spin the knob
+#define OPERATOR_LISTEN_MIN 5000       // ms
+#define OPERATOR_LISTEN_MAX 120000     // ms
+#define OPERATOR_DETENTS_MIN 10
+#define OPERATOR_DETENTS_MAX 400
+#define OPERATOR_DETENT_MIN_MS 15      // fast spin
+#define OPERATOR_DETENT_MAX_MS 80      // slow, deliberate tuning
+#define OPERATOR_BAND_LOW 7000000UL    // 40m band edges
+#define OPERATOR_BAND_HIGH 7300000UL
+
+// A frequency change larger than this is a relocation rather than operator drift
+#define RELOCATION_JUMP_HZ 1000.0
+
+struct Operator {
+    bool enabled;
+    unsigned long next_time;    // next knob detent, or end of listening
+    int detents_left;           // remaining detents in the current spin
+    int direction;
+    unsigned long detent_ms;
+};
+
+struct Stats {
+    unsigned long passes;
+    unsigned long gen_busy_ms[RIG_NUM_WAVEGENS];
+    unsigned long in_use_ms[RIG_NUM_WAVEGENS + 1];   // time with 0..4 generators busy
+    unsigned long handoffs;
+    unsigned long relocations;
+    unsigned long tune_detents;
+};
+
+static Operator op;
+static Stats total;
+static Stats hour;
+
+static unsigned long station_realized_ms[RIG_NUM_STATIONS];
+static unsigned long station_acquisitions[RIG_NUM_STATIONS];
+static unsigned long station_moves[RIG_NUM_STATIONS];
+static int last_realizer[RIG_NUM_STATIONS];
+static float last_frequency[RIG_NUM_STATIONS];
+
+// ========================================
+// SIMULATED OPERATOR
+// ========================================
+void operator_listen(unsigned long time){
+    op.detents_left = 0;
+    op.next_time = time + random(OPERATOR_LISTEN_MIN, OPERATOR_LISTEN_MAX + 1);
+}
+
+void operator_begin_spin(unsigned long time){
+    op.detents_left = random(OPERATOR_DETENTS_MIN, OPERATOR_DETENTS_MAX + 1);
+    op.detent_ms = random(OPERATOR_DETENT_MIN_MS, OPERATOR_DETENT_MAX_MS + 1);
+    op.direction = random(2) ? 1 : -1;
+
+    // Turn back at the band edges
+    unsigned long span = (unsigned long)op.detents_left * vfoa._step;
+    if(op.direction > 0 && vfoa._frequency + span > OPERATOR_BAND_HIGH)
+        op.direction = -1;
+    else if(op.direction < 0 && vfoa._frequency < OPERATOR_BAND_LOW + span)
+        op.direction = 1;
+
+    op.next_time = time;
+}
+
+// returns true if a detent was turned
+bool operator_step(unsigned long time){
+    if(!op.enabled || time < op.next_time)
+        return false;
+
+    if(op.detents_left == 0){
+        operator_begin_spin(time);
+    }
+
+    rig_turn_tuning(op.direction);
+    op.detents_left--;
+
+    if(op.detents_left == 0)
+        operator_listen(time);
+    else
+        op.next_time = time + op.detent_ms;
+    return true;
+}
+
+// ========================================
+// ACCOUNTING
+// ========================================
+// credit the state left by the previous pass with the time until this one
+void account_interval(unsigned long elapsed){
+    int in_use = 0;
+    for(int i = 0; i < RIG_NUM_WAVEGENS; i++){
+        if(rig_wavegen_stats[i]){
+            in_use++;
+            total.gen_busy_ms[i] += elapsed;
+            hour.gen_busy_ms[i] += elapsed;
+        }
+    }
+    total.in_use_ms[in_use] += elapsed;
+    hour.in_use_ms[in_use] += elapsed;
+
+    for(int i = 0; i < RIG_NUM_STATIONS; i++){
+        if(last_realizer[i] != -1)
+            station_realized_ms[i] += elapsed;
+    }
+}
+
+// look for handoffs and relocations made by this pass
+void account_pass(){
+    total.passes++;
+    hour.passes++;
+
+    for(int i = 0; i < RIG_NUM_STATIONS; i++){
+        int realizer = station_pool[i]->_realizer;
+        if(realizer != -1 && last_realizer[i] == -1){
+            station_acquisitions[i]++;
+            total.handoffs++;
+            hour.handoffs++;
+        }
+        last_realizer[i] = realizer;
+
+        float frequency = station_pool[i]->get_fixed_frequency();
+        if(fabs(frequency - last_frequency[i]) > RELOCATION_JUMP_HZ)
+            station_moves[i]++;
+        last_frequency[i] = frequency;
+    }
+
+    unsigned long relocations = station_manager.getRelocationCount();
+    hour.relocations += relocations - total.relocations;
+    total.relocations = relocations;
+}
+
+// ========================================
+// REPORTING
+// ========================================
+void print_percent(unsigned long part, unsigned long whole){
+    Serial.print(whole ? (100.0 * part) / whole : 0.0, 1);
+    Serial.print("%");
+}
+
+void print_hour_header(){
+    Serial.println("hour  gens-busy  gen1    gen2    gen3    gen4    moves  handoffs  detents  passes");
+}
+
+void print_hour(unsigned long n){
+    unsigned long busy = 0;
+    for(int i = 0; i < RIG_NUM_WAVEGENS; i++)
+        busy += hour.gen_busy_ms[i];
+
+    Serial.print(n);
+    Serial.print("\t");
+    Serial.print((double)busy / MS_PER_HOUR, 2);
+    Serial.print("\t");
+    for(int i = 0; i < RIG_NUM_WAVEGENS; i++){
+        Serial.print("   ");
+        print_percent(hour.gen_busy_ms[i], MS_PER_HOUR);
+    }
+    Serial.print("\t");
+    Serial.print(hour.relocations);
+    Serial.print("\t");
+    Serial.print(hour.handoffs);
+    Serial.print("\t");
+    Serial.print(hour.tune_detents);
+    Serial.print("\t");
+    Serial.println(hour.passes);
+
+    memset(&hour, 0, sizeof(hour));
+}
+
+void print_summary(unsigned long sim_ms, double wall_seconds){
+    double hours = (double)sim_ms / MS_PER_HOUR;
+
+    Serial.println();
+    Serial.print("Simulated ");
+    Serial.print(hours, 2);
+    Serial.print(" h in ");
+    Serial.print(wall_seconds, 2);
+    Serial.print(" s (");
+    Serial.print(wall_seconds > 0.0 ? (sim_ms / 1000.0) / wall_seconds : 0.0, 0);
+    Serial.print("x), ");
+    Serial.print(total.passes);
+    Serial.print(" loop passes for ");
+    Serial.print(sim_ms);
+    Serial.println(" ms");
+
+    Serial.println("Generators in use (share of time):");
+    for(int n = 0; n <= RIG_NUM_WAVEGENS; n++){
+        Serial.print("  ");
+        Serial.print(n);
+        Serial.print(": ");
+        print_percent(total.in_use_ms[n], sim_ms);
+        Serial.println();
+    }
+    for(int i = 0; i < RIG_NUM_WAVEGENS; i++){
+        Serial.print("Generator ");
+        Serial.print(i + 1);
+        Serial.print(" occupancy: ");
+        print_percent(total.gen_busy_ms[i], sim_ms);
+        Serial.println();
+    }
+
+    Serial.print("Relocations: ");
+    Serial.print(total.relocations);
+    Serial.print(" (");
+    Serial.print(hours > 0.0 ? total.relocations / hours : 0.0, 1);
+    Serial.println("/h)");
+    Serial.print("Generator handoffs: ");
+    Serial.print(total.handoffs);
+    Serial.print(" (");
+    Serial.print(hours > 0.0 ? total.handoffs / hours : 0.0, 1);
+    Serial.println("/h)");
+    Serial.print("Tuning detents: ");
+    Serial.println(total.tune_detents);
+
+    Serial.println();
+    Serial.println("station  type     frequency   realized  acquisitions  moves");
+    for(int i = 0; i < RIG_NUM_STATIONS; i++){
+        Serial.print(i + 1);
+        Serial.print("\t ");
+        Serial.print(rig_station_type(i));
+        Serial.print("\t  ");
+        Serial.print((unsigned long)station_pool[i]->get_fixed_frequency());
+        Serial.print("\t");
+        print_percent(station_realized_ms[i], sim_ms);
+        Serial.print("\t");
+        Serial.print(station_acquisitions[i]);
+        Serial.print("\t\t");
+        Serial.println(station_moves[i]);
+    }
+
+    Serial.println();
+    ad9833_recorder.print_report(sim_ms, rig_owner_name);
+}
+
+// ========================================
+// MAIN
+// ========================================
+int main(int argc, char **argv){
+    unsigned long hours = argc > 1 ? strtoul(argv[1], NULL, 10) : DEFAULT_SIM_HOURS;
+    unsigned long seed = argc > 2 ? strtoul(argv[2], NULL, 10) : DEFAULT_SIM_SEED;
+    op.enabled = argc > 3 ? atoi(argv[3]) != 0 : true;
+    randomSeed(seed);
+
+    rig_setup();
+    rig_start_stations();
+
+    unsigned long time = millis();
+    unsigned long end_time = time + hours * MS_PER_HOUR;
+    unsigned long next_hour = time + MS_PER_HOUR;
+    unsigned long hour_number = 1;
+    unsigned long last_pass_time = time;
+    int passes_this_ms = 0;
+
+    for(int i = 0; i < RIG_NUM_STATIONS; i++){
+        last_realizer[i] = station_pool[i]->_realizer;
+        last_frequency[i] = station_pool[i]->get_fixed_frequency();
+    }
+    operator_listen(time);
+
+    print_hour_header();
+    clock_t wall_start = clock();
+
+    while(time < end_time){
+        account_interval(time - last_pass_time);
+        last_pass_time = time;
+
+        if(operator_step(time)){
+            total.tune_detents++;
+            hour.tune_detents++;
+        }
+
+        rig_loop_pass(time);
+        account_pass();
+
+        // Jump to whatever happens next
+        unsigned long next_time = rig_next_event_time(time);
+        if(op.enabled && op.next_time < next_time)
+            next_time = op.next_time;
+
+        if(next_time <= time){
+            if(++passes_this_ms < MAX_PASSES_PER_MS){
+                next_time = time;
+            } else {
+                next_time = time + 1;
+                passes_this_ms = 0;
+            }
+        } else {
+            passes_this_ms = 0;
+        }
+        if(next_time > end_time)
+            next_time = end_time;
+
+        while(next_time >= next_hour){
+            account_interval(next_hour - last_pass_time);
+            last_pass_time = next_hour;
+            print_hour(hour_number++);
+            next_hour += MS_PER_HOUR;
+        }
+
+        time = next_time;
+        native_set_micros((uint64_t)time * 1000);
+    }
+
+    account_interval(end_time - last_pass_time);
+
+    double wall_seconds = (double)(clock() - wall_start) / CLOCKS_PER_SEC;
+    print_summary(hours * MS_PER_HOUR, wall_seconds);
+    return 0;
+}
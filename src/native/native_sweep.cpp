@@ -0,0 +1,287 @@
+// ============================================================================
+// PIPELINE TUNING-SWEEP STRESS HARNESS
+// ============================================================================
+// Drives the host rig's VFO through scripted and randomized trajectories
+// (slow scans, fast sweeps, reversals, long parks, a random walk) and measures
+// StationManager::updateStations() on every loop pass:
+//   - host execution time per call (mean, p99, max)
+//   - stations moved by reallocateStations(), in total and worst case per call
+//   - pops: stations entering AUDIBLE within PIPELINE_AUDIBLE_RANGE of the VFO,
+//     and how many of those had just been relocated there
+//   - wave generator acquisition failures (WaveGenPool::get_failed_count())
+//
+// The relocation placement offsets are printed with the results; they can be
+// overridden with build flags (e.g. -DPIPELINE_PLACE_DOWN_OFFSET=7200) to
+// compare placements on the same trajectories and seed.
+//
+// Host timings only rank changes against each other; they are not AVR cycles.
+//
+// USAGE:
+//   pio run -e native_sweep && .pio/build/native_sweep/program [seed]
+
+#include <Arduino.h>
+#include <algorithm>
+#include <vector>
+#include "native_rig.h"
+
+#define DEFAULT_SWEEP_SEED 1
+
+// Parked before each scenario so the pipeline has paused (settle time is 5 s)
+#define SETTLE_MS 6000UL
+
+// Same cap as native_sim on back-to-back passes at one millisecond
+#define MAX_PASSES_PER_MS 8
+
+// A frequency change larger than this is a relocation rather than drift
+#define RELOCATION_JUMP_HZ 1000.0
+
+// Random walk: segment count and limits
+#define RANDOM_SEGMENTS 40
+#define RANDOM_MAX_RATE 200            // detents per second
+#define RANDOM_MIN_MS 1000
+#define RANDOM_MAX_MS 20000
+#define RANDOM_PARK_PERCENT 30
+
+struct Segment {
+    long rate;                  // detents per second, negative tunes down, 0 parks
+    unsigned long duration;     // ms
+};
+
+struct Scenario {
+    const char *name;
+    const Segment *segments;
+    int count;
+};
+
+const Segment slow_scan_up[] = {{12, 60000}};
+const Segment slow_scan_down[] = {{-12, 60000}};
+const Segment fast_sweep_up[] = {{200, 10000}};
+const Segment fast_sweep_down[] = {{-200, 10000}};
+const Segment reversals[] = {
+    {60, 3000}, {-60, 3000}, {60, 3000}, {-60, 3000},
+    {60, 3000}, {-60, 3000}, {60, 3000}, {-60, 3000},
+    {150, 1000}, {-150, 1000}, {150, 1000}, {-150, 1000}
+};
+const Segment park_and_jump[] = {
+    {0, 120000}, {100, 5000}, {0, 120000}, {-100, 5000}, {0, 120000}
+};
+static Segment random_walk[RANDOM_SEGMENTS];
+
+const Scenario scenarios[] = {
+    {"slow-scan-up", slow_scan_up, 1},
+    {"slow-scan-down", slow_scan_down, 1},
+    {"fast-sweep-up", fast_sweep_up, 1},
+    {"fast-sweep-down", fast_sweep_down, 1},
+    {"reversals", reversals, sizeof(reversals) / sizeof(reversals[0])},
+    {"park-and-jump", park_and_jump, sizeof(park_and_jump) / sizeof(park_and_jump[0])},
+    {"random-walk", random_walk, RANDOM_SEGMENTS},
+};
+
+struct Stats {
+    unsigned long duration;
+    double tuned_hz;
+    std::vector<double> call_ns;
+    unsigned long moves;
+    unsigned long max_moves;
+    unsigned long pops;
+    unsigned long relocation_pops;
+    unsigned long acquisition_failures;
+};
+
+static StationState last_state[RIG_NUM_STATIONS];
+static float last_frequency[RIG_NUM_STATIONS];
+
+// ========================================
+// TRAJECTORIES
+// ========================================
+void build_random_walk(){
+    for(int i = 0; i < RANDOM_SEGMENTS; i++){
+        random_walk[i].duration = random(RANDOM_MIN_MS, RANDOM_MAX_MS + 1);
+        if(random(100) < RANDOM_PARK_PERCENT)
+            random_walk[i].rate = 0;
+        else
+            random_walk[i].rate = random(1, RANDOM_MAX_RATE + 1) * (random(2) ? 1 : -1);
+    }
+}
+
+// ========================================
+// MEASUREMENT
+// ========================================
+void snapshot_stations(){
+    for(int i = 0; i < RIG_NUM_STATIONS; i++){
+        last_state[i] = station_pool[i]->get_station_state();
+        last_frequency[i] = station_pool[i]->get_fixed_frequency();
+    }
+}
+
+void account_pass(Stats *stats, unsigned long moves){
+    stats->call_ns.push_back(rig_update_stations_ns);
+    stats->moves += moves;
+    if(moves > stats->max_moves)
+        stats->max_moves = moves;
+
+    for(int i = 0; i < RIG_NUM_STATIONS; i++){
+        StationState state = station_pool[i]->get_station_state();
+        float frequency = station_pool[i]->get_fixed_frequency();
+        if(state == AUDIBLE && last_state[i] != AUDIBLE &&
+           fabs(frequency - (float)vfoa._frequency) <= PIPELINE_AUDIBLE_RANGE){
+            stats->pops++;
+            if(fabs(frequency - last_frequency[i]) > RELOCATION_JUMP_HZ)
+                stats->relocation_pops++;
+        }
+    }
+}
+
+// run segments from time, measuring into stats if given; returns the end time
+unsigned long run_segments(unsigned long time, const Segment *segments, int count, Stats *stats){
+    int passes_this_ms = 0;
+
+    for(int s = 0; s < count; s++){
+        const Segment &segment = segments[s];
+        unsigned long end_time = time + segment.duration;
+        unsigned long detent_ms = segment.rate ? 1000UL / labs(segment.rate) : 0;
+        if(segment.rate && detent_ms == 0)
+            detent_ms = 1;
+        unsigned long next_detent = segment.rate ? time : NO_PENDING_EVENT;
+
+        while(time < end_time){
+            if(time >= next_detent){
+                rig_turn_tuning(segment.rate > 0 ? 1 : -1);
+                next_detent += detent_ms;
+            }
+
+            long last_vfo = vfoa._frequency;
+            unsigned long relocations = station_manager.getRelocationCount();
+            snapshot_stations();
+
+            rig_loop_pass(time);
+
+            if(stats){
+                stats->tuned_hz += labs((long)vfoa._frequency - last_vfo);
+                account_pass(stats, station_manager.getRelocationCount() - relocations);
+            }
+
+            unsigned long next_time = rig_next_event_time(time);
+            if(next_detent < next_time)
+                next_time = next_detent;
+            if(next_time <= time){
+                if(++passes_this_ms < MAX_PASSES_PER_MS){
+                    next_time = time;
+                } else {
+                    next_time = time + 1;
+                    passes_this_ms = 0;
+                }
+            } else {
+                passes_this_ms = 0;
+            }
+            if(next_time > end_time)
+                next_time = end_time;
+
+            time = next_time;
+            native_set_micros((uint64_t)time * 1000);
+        }
+        if(stats)
+            stats->duration += segment.duration;
+    }
+    return time;
+}
+
+// ========================================
+// REPORTING
+// ========================================
+void print_header(){
+    Serial.print("Placement: up +");
+    Serial.print(PIPELINE_PLACE_UP_OFFSET);
+    Serial.print(" Hz step ");
+    Serial.print(PIPELINE_PLACE_UP_STEP);
+    Serial.print(", down -");
+    Serial.print(PIPELINE_PLACE_DOWN_OFFSET);
+    Serial.print(" Hz step ");
+    Serial.print(PIPELINE_PLACE_DOWN_STEP);
+    Serial.print("; audible range ");
+    Serial.print(PIPELINE_AUDIBLE_RANGE);
+    Serial.println(" Hz");
+    Serial.println();
+    Serial.println("scenario          min    kHz    calls    ns-mean  ns-p99  ns-max   moves  max/call  pops  pops/min  reloc-pops  acq-fail");
+}
+
+void print_padded(const char *text, int width){
+    Serial.print(text);
+    for(int i = strlen(text); i < width; i++)
+        Serial.print(" ");
+}
+
+void print_stats(const char *name, Stats *stats){
+    std::vector<double> &ns = stats->call_ns;
+    std::sort(ns.begin(), ns.end());
+    double sum = 0.0;
+    for(size_t i = 0; i < ns.size(); i++)
+        sum += ns[i];
+    double minutes = stats->duration / 60000.0;
+
+    print_padded(name, 18);
+    Serial.print(minutes, 1);
+    Serial.print("\t");
+    Serial.print(stats->tuned_hz / 1000.0, 1);
+    Serial.print("\t");
+    Serial.print((unsigned long)ns.size());
+    Serial.print("\t");
+    Serial.print(ns.empty() ? 0.0 : sum / ns.size(), 0);
+    Serial.print("\t");
+    Serial.print(ns.empty() ? 0.0 : ns[(ns.size() - 1) * 99 / 100], 0);
+    Serial.print("\t");
+    Serial.print(ns.empty() ? 0.0 : ns.back(), 0);
+    Serial.print("\t");
+    Serial.print(stats->moves);
+    Serial.print("\t");
+    Serial.print(stats->max_moves);
+    Serial.print("\t  ");
+    Serial.print(stats->pops);
+    Serial.print("\t");
+    Serial.print(minutes > 0.0 ? stats->pops / minutes : 0.0, 2);
+    Serial.print("\t  ");
+    Serial.print(stats->relocation_pops);
+    Serial.print("\t      ");
+    Serial.println(stats->acquisition_failures);
+}
+
+// ========================================
+// MAIN
+// ========================================
+int main(int argc, char **argv){
+    unsigned long seed = argc > 1 ? strtoul(argv[1], NULL, 10) : DEFAULT_SWEEP_SEED;
+    randomSeed(seed);
+    build_random_walk();
+
+    rig_setup();
+    rig_start_stations();
+    print_header();
+
+    unsigned long time = millis();
+    const Segment settle = {0, SETTLE_MS};
+    Stats total = {};
+
+    for(unsigned int n = 0; n < sizeof(scenarios) / sizeof(scenarios[0]); n++){
+        const Scenario &scenario = scenarios[n];
+        time = run_segments(time, &settle, 1, NULL);
+
+        Stats stats = {};
+        unsigned long failures = wave_gen_pool.get_failed_count();
+        time = run_segments(time, scenario.segments, scenario.count, &stats);
+        stats.acquisition_failures = wave_gen_pool.get_failed_count() - failures;
+
+        total.duration += stats.duration;
+        total.tuned_hz += stats.tuned_hz;
+        total.call_ns.insert(total.call_ns.end(), stats.call_ns.begin(), stats.call_ns.end());
+        total.moves += stats.moves;
+        if(stats.max_moves > total.max_moves)
+            total.max_moves = stats.max_moves;
+        total.pops += stats.pops;
+        total.relocation_pops += stats.relocation_pops;
+        total.acquisition_failures += stats.acquisition_failures;
+
+        print_stats(scenario.name, &stats);
+    }
+    print_stats("all", &total);
+    return 0;
+}
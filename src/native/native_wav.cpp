@@ -0,0 +1,375 @@
+// ============================================================================
+// AD9833 TRACE TO WAV RENDERER
+// ============================================================================
+// Replays a timestamped AD9833 register trace through a model of each chip
+// (FREQ0/FREQ1 with the B28 two-word sequence or HLB half writes, FSELECT,
+// RESET) and synthesizes the summed sine output of the four generators into
+// a 16-bit mono WAV. The oscillators are phase accumulators like the DDS
+// core, so retunes and FSELECT flips are phase-continuous exactly as on the
+// hardware; only RESET returns the phase to zero.
+//
+// The trace comes either from running the host rig (recorded by the
+// MD_AD9833_RECORDING driver) or from a text file, one write per line:
+//   <micros> <chip 0-3> <16-bit word in hex>
+// A rig run also writes its trace next to the WAV (<out>.trace) so runs can
+// be diffed between revisions.
+//
+// Besides the audio, reports per chip the number of audible onsets (active
+// frequency entering MIN_AUDIBLE_HZ..MAX_AUDIBLE_FREQ from outside it, with
+// the onset pitch: relocation "pops" show up as onsets near 5 kHz) and the
+// largest sample-to-sample step in the mix, a rough click measure.
+//
+// USAGE:
+//   pio run -e native_wav && .pio/build/native_wav/program [seconds] [seed] [sweep] [out.wav]
+//   sweep: tuning detents per second, negative tunes down (default 0, VFO parked)
+//   .pio/build/native_wav/program <trace.txt> [out.wav]
+
+#include <Arduino.h>
+#include <MD_AD9833_Recorder.h>
+#include <ctype.h>
+#include <math.h>
+#include <stdio.h>
+#include <vector>
+#include "native_rig.h"
+#include "sim_transmitter.h"
+
+#define DEFAULT_RENDER_SECONDS 60
+#define DEFAULT_RENDER_SEED 1
+#define DEFAULT_WAV_FILE "fluxtune.wav"
+
+// A trace file is rendered to its last write plus this, so the final state is heard
+#define TRACE_TAIL_US 1000000UL
+
+#define SAMPLE_RATE 44100
+#define AD9833_MCLK 25000000.0
+#define AD9833_FREQ_SCALE 268435456.0   // 2^28
+
+// Below this the generator is parked (SILENT_FREQ is 0.1 Hz)
+#define MIN_AUDIBLE_HZ 20.0
+
+// Output coupling: a one-pole DC blocker stands in for the audio path's
+// coupling capacitor, so parked generators don't leave a wandering offset
+#define DC_BLOCK_POLE 0.999
+
+// Each generator gets an equal share of full scale
+#define CHIP_GAIN (32767.0 / RIG_NUM_WAVEGENS)
+
+// Same cap as native_sim on back-to-back passes at one millisecond
+#define MAX_PASSES_PER_MS 8
+
+// AD9833 register layout
+#define REG_SELECT_MASK 0xC000
+#define REG_CONTROL 0x0000
+#define REG_FREQ0 0x4000
+#define REG_FREQ1 0x8000
+#define REG_PHASE 0xC000
+#define CTL_B28 0x2000
+#define CTL_HLB 0x1000
+#define CTL_FSELECT 0x0800
+#define CTL_RESET 0x0100
+#define FREQ_DATA_MASK 0x3FFF
+
+struct ChipModel {
+    uint32_t freq[2];       // 28-bit tuning words
+    bool b28;
+    bool hlb;
+    bool fselect;
+    bool reset;
+    bool lsb_pending;       // B28: LSB word received, waiting for MSB
+    uint16_t lsb;
+    int lsb_reg;
+    double phase;           // cycles, 0..1
+    bool audible;
+    unsigned long onsets;
+};
+
+static ChipModel chips[RIG_NUM_WAVEGENS];
+
+// ========================================
+// CHIP MODEL
+// ========================================
+void chip_init(ChipModel *chip){
+    memset(chip, 0, sizeof(*chip));
+    chip->b28 = true;
+}
+
+void chip_write(ChipModel *chip, uint16_t word){
+    uint16_t reg = word & REG_SELECT_MASK;
+    uint16_t data = word & FREQ_DATA_MASK;
+
+    if(reg == REG_CONTROL){
+        chip->b28 = word & CTL_B28;
+        chip->hlb = word & CTL_HLB;
+        chip->fselect = word & CTL_FSELECT;
+        chip->reset = word & CTL_RESET;
+        chip->lsb_pending = false;
+        if(chip->reset)
+            chip->phase = 0.0;
+        return;
+    }
+    if(reg == REG_PHASE)
+        return;     // phase offsets are not used by FluxTune
+
+    int n = reg == REG_FREQ0 ? 0 : 1;
+    if(chip->b28){
+        // Two consecutive writes to the same register: LSBs then MSBs,
+        // the register takes the new word after the second
+        if(chip->lsb_pending && chip->lsb_reg == n){
+            chip->freq[n] = ((uint32_t)data << 14) | chip->lsb;
+            chip->lsb_pending = false;
+        } else {
+            chip->lsb = data;
+            chip->lsb_reg = n;
+            chip->lsb_pending = true;
+        }
+    } else if(chip->hlb){
+        chip->freq[n] = (chip->freq[n] & 0x3FFF) | ((uint32_t)data << 14);
+    } else {
+        chip->freq[n] = (chip->freq[n] & 0xFFFC000UL) | data;
+    }
+}
+
+double chip_frequency(const ChipModel *chip){
+    return chip->freq[chip->fselect ? 1 : 0] * AD9833_MCLK / AD9833_FREQ_SCALE;
+}
+
+// ========================================
+// TRACE SOURCES
+// ========================================
+void capture_rig(unsigned long seconds, long sweep, std::vector<AD9833Write> &trace){
+    rig_setup();
+    rig_start_stations();
+
+    unsigned long time = millis();
+    unsigned long end_time = time + seconds * 1000UL;
+    unsigned long detent_ms = sweep ? 1000UL / labs(sweep) : 0;
+    unsigned long next_detent = sweep ? time + detent_ms : NO_PENDING_EVENT;
+    int passes_this_ms = 0;
+
+    while(time < end_time){
+        if(time >= next_detent){
+            rig_turn_tuning(sweep > 0 ? 1 : -1);
+            next_detent += detent_ms ? detent_ms : 1;
+        }
+
+        rig_loop_pass(time);
+
+        unsigned long next_time = rig_next_event_time(time);
+        if(next_detent < next_time)
+            next_time = next_detent;
+        if(next_time <= time){
+            if(++passes_this_ms < MAX_PASSES_PER_MS){
+                next_time = time;
+            } else {
+                next_time = time + 1;
+                passes_this_ms = 0;
+            }
+        } else {
+            passes_this_ms = 0;
+        }
+        if(next_time > end_time)
+            next_time = end_time;
+
+        time = next_time;
+        native_set_micros((uint64_t)time * 1000);
+    }
+
+    if(ad9833_recorder.get_dropped()){
+        Serial.print("Warning: trace ring overflowed, oldest ");
+        Serial.print(ad9833_recorder.get_dropped());
+        Serial.println(" writes lost; render starts from an unknown chip state");
+    }
+    for(unsigned long i = 0; i < ad9833_recorder.get_count(); i++)
+        trace.push_back(ad9833_recorder.get_write(i));
+}
+
+bool load_trace(const char *path, std::vector<AD9833Write> &trace){
+    FILE *file = fopen(path, "r");
+    if(!file)
+        return false;
+
+    unsigned long time;
+    unsigned int chip, word;
+    while(fscanf(file, "%lu %u %x", &time, &chip, &word) == 3){
+        if(chip >= RIG_NUM_WAVEGENS)
+            continue;
+        AD9833Write entry;
+        entry.time = time;
+        entry.chip = chip;
+        entry.word = word;
+        entry.owner = AD9833_NO_OWNER;
+        trace.push_back(entry);
+    }
+    fclose(file);
+    return true;
+}
+
+bool save_trace(const char *path, const std::vector<AD9833Write> &trace){
+    FILE *file = fopen(path, "w");
+    if(!file)
+        return false;
+    for(size_t i = 0; i < trace.size(); i++)
+        fprintf(file, "%lu %u %04x\n", trace[i].time, trace[i].chip, trace[i].word);
+    fclose(file);
+    return true;
+}
+
+// ========================================
+// RENDERING
+// ========================================
+void write_le(FILE *file, uint32_t value, int bytes){
+    for(int i = 0; i < bytes; i++)
+        fputc((value >> (8 * i)) & 0xFF, file);
+}
+
+void write_wav_header(FILE *file, uint32_t samples){
+    uint32_t data_bytes = samples * 2;
+    fwrite("RIFF", 1, 4, file);
+    write_le(file, 36 + data_bytes, 4);
+    fwrite("WAVEfmt ", 1, 8, file);
+    write_le(file, 16, 4);              // PCM format chunk size
+    write_le(file, 1, 2);               // PCM
+    write_le(file, 1, 2);               // mono
+    write_le(file, SAMPLE_RATE, 4);
+    write_le(file, SAMPLE_RATE * 2, 4); // byte rate
+    write_le(file, 2, 2);               // block align
+    write_le(file, 16, 2);              // bits per sample
+    fwrite("data", 1, 4, file);
+    write_le(file, data_bytes, 4);
+}
+
+// apply a write and note audible onsets for the report
+void apply_write(const AD9833Write &entry){
+    ChipModel *chip = &chips[entry.chip];
+    chip_write(chip, entry.word);
+
+    double frequency = chip_frequency(chip);
+    bool audible = !chip->reset && frequency >= MIN_AUDIBLE_HZ && frequency <= MAX_AUDIBLE_FREQ;
+    if(audible && !chip->audible){
+        chip->onsets++;
+        Serial.print("  ");
+        Serial.print(entry.time / 1000000.0, 3);
+        Serial.print(" s  chip ");
+        Serial.print(entry.chip + 1);
+        Serial.print(" on at ");
+        Serial.print(frequency, 0);
+        Serial.println(" Hz");
+    }
+    chip->audible = audible;
+}
+
+bool render(const char *path, const std::vector<AD9833Write> &trace, unsigned long end_us){
+    FILE *file = fopen(path, "wb");
+    if(!file)
+        return false;
+
+    uint32_t samples = (uint32_t)((double)end_us * SAMPLE_RATE / 1000000.0);
+    write_wav_header(file, samples);
+
+    for(int i = 0; i < RIG_NUM_WAVEGENS; i++)
+        chip_init(&chips[i]);
+
+    Serial.println("Audible onsets:");
+    size_t next_write = 0;
+    double dc_in = 0.0, dc_out = 0.0;
+    int last_sample = 0, max_step = 0;
+    double max_step_time = 0.0;
+
+    for(uint32_t n = 0; n < samples; n++){
+        double t_us = (double)n * 1000000.0 / SAMPLE_RATE;
+        while(next_write < trace.size() && trace[next_write].time <= t_us)
+            apply_write(trace[next_write++]);
+
+        double mix = 0.0;
+        for(int i = 0; i < RIG_NUM_WAVEGENS; i++){
+            ChipModel *chip = &chips[i];
+            if(chip->reset)
+                continue;   // DAC held at midscale
+            mix += sin(2.0 * M_PI * chip->phase);
+            chip->phase += chip_frequency(chip) / SAMPLE_RATE;
+            chip->phase -= floor(chip->phase);
+        }
+        mix *= CHIP_GAIN;
+
+        dc_out = mix - dc_in + DC_BLOCK_POLE * dc_out;
+        dc_in = mix;
+
+        int sample = (int)lround(dc_out);
+        if(sample > 32767) sample = 32767;
+        if(sample < -32768) sample = -32768;
+
+        int step = abs(sample - last_sample);
+        if(step > max_step){
+            max_step = step;
+            max_step_time = t_us / 1000000.0;
+        }
+        last_sample = sample;
+        write_le(file, (uint16_t)(int16_t)sample, 2);
+    }
+    fclose(file);
+
+    Serial.println();
+    Serial.print("Rendered ");
+    Serial.print((double)samples / SAMPLE_RATE, 2);
+    Serial.print(" s from ");
+    Serial.print((unsigned long)trace.size());
+    Serial.print(" writes to ");
+    Serial.println(path);
+    for(int i = 0; i < RIG_NUM_WAVEGENS; i++){
+        Serial.print("  chip ");
+        Serial.print(i + 1);
+        Serial.print(" onsets: ");
+        Serial.println(chips[i].onsets);
+    }
+    Serial.print("Largest sample step: ");
+    Serial.print(max_step);
+    Serial.print(" at ");
+    Serial.print(max_step_time, 3);
+    Serial.println(" s");
+    return true;
+}
+
+// ========================================
+// MAIN
+// ========================================
+int main(int argc, char **argv){
+    std::vector<AD9833Write> trace;
+    const char *wav_path = DEFAULT_WAV_FILE;
+    unsigned long end_us;
+
+    bool from_file = argc > 1 && !isdigit((unsigned char)argv[1][0]);
+    if(from_file){
+        if(!load_trace(argv[1], trace)){
+            Serial.print("Can't read trace ");
+            Serial.println(argv[1]);
+            return 1;
+        }
+        if(argc > 2)
+            wav_path = argv[2];
+        end_us = (trace.empty() ? 0 : trace.back().time) + TRACE_TAIL_US;
+    } else {
+        unsigned long seconds = argc > 1 ? strtoul(argv[1], NULL, 10) : DEFAULT_RENDER_SECONDS;
+        unsigned long seed = argc > 2 ? strtoul(argv[2], NULL, 10) : DEFAULT_RENDER_SEED;
+        long sweep = argc > 3 ? strtol(argv[3], NULL, 10) : 0;
+        if(argc > 4)
+            wav_path = argv[4];
+        randomSeed(seed);
+
+        capture_rig(seconds, sweep, trace);
+        end_us = seconds * 1000000UL;
+
+        char trace_path[256];
+        snprintf(trace_path, sizeof(trace_path), "%s.trace", wav_path);
+        if(!save_trace(trace_path, trace)){
+            Serial.print("Can't write ");
+            Serial.println(trace_path);
+        }
+    }
+
+    if(!render(wav_path, trace, end_us)){
+        Serial.print("Can't write ");
+        Serial.println(wav_path);
+        return 1;
+    }
+    return 0;
+}
@@ -13,9 +13,11 @@ Option_Handler::Option_Handler(Mode * mode) : ModeHandler(mode)
 bool Option_Handler::event_sink(int event, int event_data){
     Option *option = (Option*) _mode;
 
-    if(event == 1){
+    // event is the signed number of detents turned since the last pass
+    for(int i = 0; i < event; i++){
         option->next_option();
-    } else if(event == -1){
+    }
+    for(int i = 0; i > event; i--){
         option->prev_option();
     }
 
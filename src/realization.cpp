@@ -2,10 +2,13 @@
 #include "wave_gen_pool.h"
 #include "realization.h"
 
+bool Realization::_wake_pending = false;
+
 Realization::Realization(WaveGenPool *wave_gen_pool, int station_id){
     _wave_gen_pool = wave_gen_pool;
     _realizer = -1;
     _station_id = station_id;
+    _wake_time = 0;  // step on the first pass
 }
 
 // returns true on successful update
@@ -40,6 +43,15 @@ bool Realization::step(unsigned long time){
 // void Realization::internal_step(unsigned long time){
 // }
 
+// default: no schedule information, so poll again on the next millisecond
+unsigned long Realization::get_next_event_time(unsigned long time){
+    return time + 1;
+}
+
+unsigned long Realization::get_wake_time(unsigned long time){
+    return get_next_event_time(time);
+}
+
 void Realization::end(){
     if(_realizer != -1) {
         _wave_gen_pool->free_realizer(_realizer, _station_id);
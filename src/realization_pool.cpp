@@ -1,4 +1,5 @@
 #include "basic_types.h"
+#include "station_config.h"
 #include "realization.h"
 #include "realization_pool.h"
 
@@ -8,6 +9,7 @@ RealizationPool::RealizationPool(Realization **realizations, bool *statuses,  in
     _statuses = statuses;
     _nrealizations = nrealizations; 
     _hardware_dirty = false;  // Initialize as clean
+    _next_wake = 0;
 }
 
 bool RealizationPool::begin(unsigned long time){
@@ -15,19 +17,50 @@ bool RealizationPool::begin(unsigned long time){
 }
 
 bool RealizationPool::step(unsigned long time){
+    if(time < _next_wake && !Realization::_wake_pending)
+        return true;
+    Realization::_wake_pending = false;
+
+    unsigned long next_wake = NO_PENDING_EVENT;
+    bool result = true;
     for(byte i = 0; i < _nrealizations; i++){
-        if(!_realizations[i]->step(time))
-            return false;
+        Realization *realization = _realizations[i];
+        if(result && time >= realization->_wake_time){
+            if(!realization->step(time))
+                result = false;
+#ifdef ENABLE_MODULATION_TICK
+            // the modulation tick changes modulator state; read it in one piece
+            noInterrupts();
+            realization->_wake_time = realization->get_wake_time(time);
+            interrupts();
+#else
+            realization->_wake_time = realization->get_wake_time(time);
+#endif
+        }
+        if(realization->_wake_time < next_wake)
+            next_wake = realization->_wake_time;
     }
-    return true;
+    _next_wake = next_wake;
+    return result;
 }
 
 void RealizationPool::end(){
 }
 
+unsigned long RealizationPool::get_next_event_time(unsigned long time){
+    unsigned long next_event = NO_PENDING_EVENT;
+    for(byte i = 0; i < _nrealizations; i++){
+        unsigned long event = _realizations[i]->get_next_event_time(time);
+        if(event < next_event)
+            next_event = event;
+    }
+    return next_event;
+}
+
 void RealizationPool::update(Mode *mode){
     for(byte i = 0; i < _nrealizations; i++){
         _realizations[i]->update(mode);
+        _realizations[i]->wake();
     }
     
     // If hardware state is dirty (unknown), force a refresh
@@ -1,28 +1,67 @@
 #include "signal_meter.h"
 #include "hardware.h"
 
-#ifdef ENABLE_LOGARITHMIC_S_METER
-#ifndef NATIVE_BUILD
-#include <math.h>  // For log2f() function
-#else
-#include <cmath>   // For log2f() function in native builds
-#endif
-#endif
+extern int option_contrast;         // Defined in saved_data.cpp
 
-#ifndef NATIVE_BUILD
 // For both platforms - using Adafruit NeoPixel
 Adafruit_NeoPixel* SignalMeter::_led_strip = nullptr;
-extern int option_contrast;         // Defined in main.cpp (matches saved_data.cpp type)
-
-// Color values for NeoPixel (red, green, blue ordering)
-static const uint32_t LED_COLORS_NEOPIXEL[SignalMeter::LED_COUNT] = {
-    0x000F00,   // Green
-    0x000F00,   // Green  
-    0x000F00,   // Green
-    0x000F00,   // Green
-    0x0F0F00,   // Yellow
-    0x0F0F00,   // Yellow
-    0x0F0000    // Red
+
+// Channel mask per LED (red, green, blue ordering); the level comes from
+// _channel_levels, so every lit channel runs at the same 0x0F base level
+static const uint32_t LED_COLOR_MASKS[SignalMeter::LED_COUNT] = {
+    0x00FF00,   // Green
+    0x00FF00,   // Green  
+    0x00FF00,   // Green
+    0x00FF00,   // Green
+    0xFFFF00,   // Yellow
+    0xFFFF00,   // Yellow
+    0xFF0000    // Red
+};
+
+#define LED_BASE_LEVEL 0x0F
+
+// Display strength (0-255) to meter level: lit LED count in the high nibble,
+// brightness of the last lit LED (0-15 sixteenths) in the low nibble.
+// Generated from the old per-render arithmetic:
+//   display = (int)(sqrtf(strength) * 16.0f) capped at 255 (S-meter) or strength (linear)
+//   sample = display * 2; lit = min(sample / 73 + 1, 7); partial = ((sample % 73) * 16) / 73
+#ifdef ENABLE_LOGARITHMIC_S_METER
+static const uint8_t METER_LEVELS[256] PROGMEM = {
+    0x10, 0x17, 0x19, 0x1B, 0x1E, 0x1F, 0x21, 0x22, 0x23, 0x25, 0x25, 0x27, 0x28, 0x28, 0x29, 0x2A,
+    0x2C, 0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x30, 0x31, 0x32, 0x33, 0x33, 0x34, 0x34, 0x35, 0x36, 0x37,
+    0x37, 0x37, 0x38, 0x39, 0x3A, 0x3A, 0x3A, 0x3B, 0x3C, 0x3C, 0x3D, 0x3D, 0x3E, 0x3E, 0x3F, 0x3F,
+    0x40, 0x41, 0x41, 0x41, 0x42, 0x42, 0x43, 0x43, 0x44, 0x44, 0x45, 0x45, 0x45, 0x46, 0x46, 0x47,
+    0x48, 0x48, 0x48, 0x48, 0x49, 0x49, 0x4A, 0x4A, 0x4B, 0x4B, 0x4C, 0x4C, 0x4C, 0x4D, 0x4D, 0x4E,
+    0x4E, 0x4F, 0x4F, 0x4F, 0x50, 0x50, 0x50, 0x51, 0x51, 0x51, 0x52, 0x52, 0x53, 0x53, 0x53, 0x53,
+    0x54, 0x54, 0x55, 0x55, 0x56, 0x56, 0x56, 0x57, 0x57, 0x57, 0x57, 0x58, 0x58, 0x59, 0x59, 0x59,
+    0x5A, 0x5A, 0x5A, 0x5A, 0x5B, 0x5B, 0x5B, 0x5C, 0x5C, 0x5D, 0x5D, 0x5D, 0x5E, 0x5E, 0x5E, 0x5E,
+    0x5F, 0x5F, 0x5F, 0x60, 0x60, 0x60, 0x61, 0x61, 0x61, 0x61, 0x61, 0x62, 0x62, 0x62, 0x63, 0x63,
+    0x64, 0x64, 0x64, 0x64, 0x65, 0x65, 0x65, 0x65, 0x66, 0x66, 0x66, 0x67, 0x67, 0x67, 0x68, 0x68,
+    0x68, 0x68, 0x68, 0x69, 0x69, 0x69, 0x6A, 0x6A, 0x6A, 0x6B, 0x6B, 0x6B, 0x6B, 0x6C, 0x6C, 0x6C,
+    0x6C, 0x6C, 0x6D, 0x6D, 0x6D, 0x6E, 0x6E, 0x6E, 0x6F, 0x6F, 0x6F, 0x6F, 0x70, 0x70, 0x70, 0x70,
+    0x70, 0x71, 0x71, 0x71, 0x72, 0x72, 0x72, 0x72, 0x73, 0x73, 0x73, 0x73, 0x73, 0x74, 0x74, 0x74,
+    0x74, 0x75, 0x75, 0x75, 0x75, 0x76, 0x76, 0x76, 0x77, 0x77, 0x77, 0x77, 0x77, 0x77, 0x78, 0x78,
+    0x78, 0x79, 0x79, 0x79, 0x79, 0x7A, 0x7A, 0x7A, 0x7A, 0x7A, 0x7A, 0x7B, 0x7B, 0x7B, 0x7B, 0x7C,
+    0x7C, 0x7C, 0x7C, 0x7D, 0x7D, 0x7D, 0x7D, 0x7E, 0x7E, 0x7E, 0x7E, 0x7E, 0x7E, 0x7F, 0x7F, 0x7F,
+};
+#else
+static const uint8_t METER_LEVELS[256] PROGMEM = {
+    0x10, 0x10, 0x10, 0x11, 0x11, 0x12, 0x12, 0x13, 0x13, 0x13, 0x14, 0x14, 0x15, 0x15, 0x16, 0x16,
+    0x17, 0x17, 0x17, 0x18, 0x18, 0x19, 0x19, 0x1A, 0x1A, 0x1A, 0x1B, 0x1B, 0x1C, 0x1C, 0x1D, 0x1D,
+    0x1E, 0x1E, 0x1E, 0x1F, 0x1F, 0x20, 0x20, 0x21, 0x21, 0x21, 0x22, 0x22, 0x23, 0x23, 0x24, 0x24,
+    0x25, 0x25, 0x25, 0x26, 0x26, 0x27, 0x27, 0x28, 0x28, 0x28, 0x29, 0x29, 0x2A, 0x2A, 0x2B, 0x2B,
+    0x2C, 0x2C, 0x2C, 0x2D, 0x2D, 0x2E, 0x2E, 0x2F, 0x2F, 0x30, 0x30, 0x30, 0x31, 0x31, 0x32, 0x32,
+    0x33, 0x33, 0x33, 0x34, 0x34, 0x35, 0x35, 0x36, 0x36, 0x37, 0x37, 0x37, 0x38, 0x38, 0x39, 0x39,
+    0x3A, 0x3A, 0x3A, 0x3B, 0x3B, 0x3C, 0x3C, 0x3D, 0x3D, 0x3E, 0x3E, 0x3E, 0x3F, 0x3F, 0x40, 0x40,
+    0x41, 0x41, 0x41, 0x42, 0x42, 0x43, 0x43, 0x44, 0x44, 0x45, 0x45, 0x45, 0x46, 0x46, 0x47, 0x47,
+    0x48, 0x48, 0x48, 0x49, 0x49, 0x4A, 0x4A, 0x4B, 0x4B, 0x4C, 0x4C, 0x4C, 0x4D, 0x4D, 0x4E, 0x4E,
+    0x4F, 0x4F, 0x50, 0x50, 0x50, 0x51, 0x51, 0x52, 0x52, 0x53, 0x53, 0x53, 0x54, 0x54, 0x55, 0x55,
+    0x56, 0x56, 0x57, 0x57, 0x57, 0x58, 0x58, 0x59, 0x59, 0x5A, 0x5A, 0x5A, 0x5B, 0x5B, 0x5C, 0x5C,
+    0x5D, 0x5D, 0x5E, 0x5E, 0x5E, 0x5F, 0x5F, 0x60, 0x60, 0x61, 0x61, 0x61, 0x62, 0x62, 0x63, 0x63,
+    0x64, 0x64, 0x65, 0x65, 0x65, 0x66, 0x66, 0x67, 0x67, 0x68, 0x68, 0x68, 0x69, 0x69, 0x6A, 0x6A,
+    0x6B, 0x6B, 0x6C, 0x6C, 0x6C, 0x6D, 0x6D, 0x6E, 0x6E, 0x6F, 0x6F, 0x70, 0x70, 0x70, 0x71, 0x71,
+    0x72, 0x72, 0x73, 0x73, 0x73, 0x74, 0x74, 0x75, 0x75, 0x76, 0x76, 0x77, 0x77, 0x77, 0x78, 0x78,
+    0x79, 0x79, 0x7A, 0x7A, 0x7A, 0x7B, 0x7B, 0x7C, 0x7C, 0x7D, 0x7D, 0x7E, 0x7E, 0x7E, 0x7F, 0x7F,
 };
 #endif
 
@@ -30,8 +69,12 @@ SignalMeter::SignalMeter()
 {
     _accumulator = 0;
     _current_strength = 0;
+    _dirty = false;
     _last_decay_time = 0;
+    _last_frame_time = 0;
+    _levels_contrast = -1;
     _panel_led_accumulator = 0;
+    _panel_led_pwm = -1;
     _flashlight_mode = false;
     _flashlight_brightness = 0;
 }
@@ -40,7 +83,6 @@ void SignalMeter::init()
 {
     clear();
     _panel_led_accumulator = 0;
-#ifndef NATIVE_BUILD
     // Initialize NeoPixel strip for both platforms
     if (!_led_strip) {
         _led_strip = new Adafruit_NeoPixel(LED_COUNT, SIGNAL_METER_PIN, NEO_GRB + NEO_KHZ800);
@@ -48,6 +90,7 @@ void SignalMeter::init()
         _led_strip->clear();
         _led_strip->show();
     }
+#ifndef NATIVE_BUILD
     _last_decay_time = millis();
 #endif
 }
@@ -68,9 +111,9 @@ void SignalMeter::add_charge(int charge_amount)
     if (_accumulator > MAX_ACCUMULATOR) {
         _accumulator = MAX_ACCUMULATOR;
     }
-    // Update display strength based on accumulator
-    _current_strength = (_accumulator * 255) / MAX_ACCUMULATOR;
-    write_leds();
+    // Update display strength based on accumulator; rendered by the next update()
+    _current_strength = _accumulator >> 1;  // 0-510 to 0-255
+    _dirty = true;
 }
 
 void SignalMeter::update(unsigned long current_time)
@@ -81,8 +124,8 @@ void SignalMeter::update(unsigned long current_time)
             _accumulator -= DECAY_RATE;
             if (_accumulator < 0) _accumulator = 0;
             // Update display strength
-            _current_strength = (_accumulator * 255) / MAX_ACCUMULATOR;
-            write_leds();
+            _current_strength = _accumulator >> 1;
+            _dirty = true;
         }
         // Decay panel LED accumulator
         if (_panel_led_accumulator > 0) {
@@ -91,6 +134,29 @@ void SignalMeter::update(unsigned long current_time)
         }
         _last_decay_time = current_time;
     }
+
+    // One render for all the charge pulses since the last one, at most one
+    // strip refresh per FRAME_INTERVAL; a change inside the interval waits
+    if (_dirty && current_time - _last_frame_time >= FRAME_INTERVAL) {
+        if (write_leds()) {
+            _last_frame_time = current_time;
+        }
+    }
+}
+
+void SignalMeter::update_panel_led()
+{
+    int pwm = 0;
+    if (_panel_led_accumulator > 0) {
+        pwm = ((long)_panel_led_accumulator * PANEL_LOCK_LED_FULL_BRIGHTNESS) / (255 * PANEL_LED_BRIGHTNESS_DIVISOR);
+        // FULL_BRIGHTNESS above 255 saturates sooner; analogWrite() keeps only the low byte
+        if (pwm > 255) pwm = 255;
+    }
+    // Only touch the pin when the level changes - the loop calls this every pass
+    if (pwm != _panel_led_pwm) {
+        _panel_led_pwm = pwm;
+        analogWrite(WHITE_PANEL_LED, pwm);
+    }
 }
 
 void SignalMeter::update_signal_strength(int strength)
@@ -143,81 +209,68 @@ void SignalMeter::clear_flashlight_mode()
     write_leds();
 }
 
-void SignalMeter::write_leds()
+// Contrast x partial brightness for one lit channel, indexed by sixteenths
+// (0-15 for the last lit LED, 16 for a full one); rebuilt when contrast changes
+void SignalMeter::build_levels()
 {
-#ifndef NATIVE_BUILD
+    for (int i = 0; i <= 16; i++) {
+        int level = (LED_BASE_LEVEL * i) / 16;
+        _channel_levels[i] = (uint8_t)((level * option_contrast) / SIGNAL_METER_BRIGHTNESS_DIVISOR);
+    }
+    _levels_contrast = option_contrast;
+}
+
+// The strip's own pixel buffer is the frame buffer: pixels are compared
+// against it, and show() only runs when one of them changed
+bool SignalMeter::set_pixel(int index, uint32_t color)
+{
+    if (_led_strip->getPixelColor(index) == color) {
+        return false;
+    }
+    _led_strip->setPixelColor(index, color);
+    return true;
+}
+
+// Returns true if the strip was refreshed
+bool SignalMeter::write_leds()
+{
+    _dirty = false;
+    if (!_led_strip) {
+        return false;
+    }
+
+    bool changed = false;
     if (_flashlight_mode) {
         // Flashlight mode: set all LEDs to white at specified brightness
         // White is created using RGB mix since these are RGB LEDs, not RGBW
-
-        int white_brightness = _flashlight_brightness;
-        
-        // NeoPixel implementation for both platforms
-        if (_led_strip) {
-            for (int i = 0; i < LED_COUNT; i++) {
-                _led_strip->setPixelColor(i, _led_strip->Color(white_brightness, white_brightness, white_brightness));
-            }
-            _led_strip->show();
+        uint32_t white = Adafruit_NeoPixel::Color(_flashlight_brightness, _flashlight_brightness, _flashlight_brightness);
+        for (int i = 0; i < LED_COUNT; i++) {
+            changed |= set_pixel(i, white);
         }
     } else {
         // Normal signal meter mode
-        
-#ifdef ENABLE_LOGARITHMIC_S_METER
-        // Apply square root scaling for S-meter-like behavior
-        // This compresses strong signals while keeping good sensitivity for weak signals
-        // More balanced than pure logarithmic scaling
-        int display_strength;
-        if (_current_strength > 0) {
-            // Square root scaling: sqrt(x) * scale_factor
-            // Provides compression without the extreme behavior of logarithmic
-            float sqrt_value = sqrtf((float)_current_strength);
-            display_strength = (int)(sqrt_value * 16.0f);  // Scale to use 0-255 range
-            if (display_strength > 255) display_strength = 255;
-        } else {
-            display_strength = 0;
+        if (_levels_contrast != option_contrast) {
+            build_levels();
         }
-#else
-        // Linear scaling (original behavior)
-        int display_strength = _current_strength;
-#endif
-        
-        // Convert strength to LED display
-        int sample = display_strength * 2;  // Scale to 0-510
-        int on_leds = (sample / 73) + 1;     // How many full LEDs to light
-        int remain = ((sample % 73) * 16) / 73;  // Brightness of partial LED
-        
-        // Ensure we don't exceed LED count
-        if (on_leds > LED_COUNT) on_leds = LED_COUNT;
-        if (on_leds < 0) on_leds = 0;
-        
-        // NeoPixel implementation for both platforms
-        if (_led_strip) {
-            // Clear all pixels first
-            _led_strip->clear();
-            
-            // Set lit LEDs with appropriate colors and brightness
-            for (int i = 0; i < on_leds; i++) {
-                uint32_t color = LED_COLORS_NEOPIXEL[i];
-                uint8_t r = (color >> 16) & 0xFF;
-                uint8_t g = (color >> 8) & 0xFF;
-                uint8_t b = color & 0xFF;
-                
-                // Apply partial brightness to last LED
-                if (i == on_leds - 1) {
-                    r = (r * remain) / 16;
-                    g = (g * remain) / 16;
-                    b = (b * remain) / 16;
-                }
-                
-                // Apply contrast adjustment
-                r = (r * option_contrast) / SIGNAL_METER_BRIGHTNESS_DIVISOR;
-                g = (g * option_contrast) / SIGNAL_METER_BRIGHTNESS_DIVISOR;
-                b = (b * option_contrast) / SIGNAL_METER_BRIGHTNESS_DIVISOR;
-                
-                _led_strip->setPixelColor(i, _led_strip->Color(r, g, b));
+
+        uint8_t level = pgm_read_byte(&METER_LEVELS[_current_strength]);
+        int on_leds = level >> 4;
+        uint8_t partial = _channel_levels[level & 0x0F];
+        uint8_t full = _channel_levels[16];
+
+        for (int i = 0; i < LED_COUNT; i++) {
+            uint32_t color = 0;
+            if (i < on_leds) {
+                // Last lit LED carries the partial brightness
+                uint8_t channel = (i == on_leds - 1) ? partial : full;
+                color = LED_COLOR_MASKS[i] & (channel * 0x010101UL);
             }
-            _led_strip->show();
+            changed |= set_pixel(i, color);
         }
     }
-#endif
+
+    if (changed) {
+        _led_strip->show();
+    }
+    return changed;
 }
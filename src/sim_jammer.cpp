@@ -46,7 +46,7 @@ void SimJammer::realize()
     
     if(_active && _jammer.get_current_state() == JAMMER_STATE_TRANSMITTING) {
         // Calculate current jamming frequency
-        float jamming_frequency = _frequency + _jammer.get_frequency_offset();
+        float jamming_frequency = audio_frequency() + _jammer.get_frequency_offset();
         
         // Set jamming frequency on both channels
         wavegen->set_frequency(jamming_frequency, true);
@@ -98,3 +98,12 @@ bool SimJammer::step(unsigned long time)
     return true;
 }
 
+unsigned long SimJammer::get_next_event_time(unsigned long time)
+{
+    if (!_jammer.is_running()) {
+        return NO_PENDING_EVENT;
+    }
+    unsigned long next_event = _jammer.get_next_event_time();
+    return (next_event == 0) ? time : next_event;
+}
+
@@ -9,7 +9,7 @@
 #define INTER_CYCLE_DELAY 8000  // 8 seconds delay between complete cycles
 
 SimNumbers::SimNumbers(WaveGenPool *wave_gen_pool, SignalMeter *signal_meter, float fixed_freq, int wpm) 
-    : SimTransmitter(wave_gen_pool, fixed_freq), _wpm(wpm), _signal_meter(signal_meter)
+    : SimTransmitter(wave_gen_pool, fixed_freq), _keyer(&_morse), _wpm(wpm), _signal_meter(signal_meter)
 {
     // Base class initializes all common variables, including _fixed_freq
     _groups_sent = 0;
@@ -49,7 +49,7 @@ bool SimNumbers::begin(unsigned long time)
     realize();  // CRITICAL: Set active state for audio output!
     
     generate_interval_signal();
-    _morse.start_morse(_group_buffer, _wpm);  // No repeat, stations handle their own repetition
+    start_group();  // No repeat, stations handle their own repetition
 
     return true;
 }
@@ -57,15 +57,33 @@ bool SimNumbers::begin(unsigned long time)
 void SimNumbers::realize()
 {
     if(_realizer == -1) {
+        _keyer.set_output(NULL);
         return;  // No WaveGen allocated
     }
     
     if(!check_frequency_bounds()) {
+        _keyer.set_output(NULL);
         return;  // Out of audible range
     }
     
     WaveGen *wavegen = _wave_gen_pool->access_realizer(_realizer);
-    wavegen->set_active_frequency(_active);
+    _keyer.set_output(wavegen);
+    if(!_keyer.is_keying())
+        wavegen->set_active_frequency(_active);
+}
+
+// the generator is about to go back to the pool; stop the tick keying it
+void SimNumbers::end()
+{
+    _keyer.set_output(NULL);
+    SimTransmitter::end();
+}
+
+void SimNumbers::start_group()
+{
+    _keyer.hold();
+    _morse.start_morse(_group_buffer, _wpm);
+    _keyer.release();
 }
 
 bool SimNumbers::update(Mode *mode)
@@ -74,7 +92,7 @@ bool SimNumbers::update(Mode *mode)
     
     if(_enabled && _realizer != -1){
         WaveGen *wavegen = _wave_gen_pool->access_realizer(_realizer);
-        wavegen->set_frequency(_frequency);
+        wavegen->set_frequency_word(WaveGen::tuning_word_dhz(_frequency_dhz));
     }
 
     realize();
@@ -84,7 +102,7 @@ bool SimNumbers::update(Mode *mode)
 // JH! platformio memory inspection shows this method as one of the top 5 largest objects
 bool SimNumbers::step(unsigned long time)
 {    // Handle morse code timing
-    int morse_state = _morse.step_morse(time);
+    int morse_state = _keyer.step(time);
       switch(morse_state){
         case STEP_MORSE_TURN_ON:
             _active = true;
@@ -164,17 +182,17 @@ bool SimNumbers::step(unsigned long time)
         
         switch(_current_phase) {            case PHASE_INTERVAL_SIGNAL:
                 generate_interval_signal();
-                _morse.start_morse(_group_buffer, _wpm);
+                start_group();
                 break;
                 
             case PHASE_NUMBERS:
                 generate_next_number_group();
-                _morse.start_morse(_group_buffer, _wpm);
+                start_group();
                 break;
                 
             case PHASE_ENDING:
                 generate_ending_sequence();
-                _morse.start_morse(_group_buffer, _wpm);
+                start_group();
                 break;            case PHASE_CYCLE_DELAY:
                 // DYNAMIC PIPELINING: Try to reallocate WaveGen for next cycle
                 if(begin(time)) {  // Only proceed if WaveGen is available
@@ -189,7 +207,7 @@ bool SimNumbers::step(unsigned long time)
                     force_frequency_update();
                     realize();  // CRITICAL: Reactivate after frequency drift update!
                       generate_interval_signal();
-                    _morse.start_morse(_group_buffer, _wpm);
+                    start_group();
                 } else {
                     // WaveGen not available - extend cycle delay and try again later
                     _next_group_time = time + 1000;  // Try again in 1 second
@@ -200,6 +218,25 @@ bool SimNumbers::step(unsigned long time)
     
     return true;
 }
+
+// earliest of the next Morse element and the end of the group/cycle delay
+unsigned long SimNumbers::get_next_event_time(unsigned long time)
+{
+    unsigned long next_event = NO_PENDING_EVENT;
+    if(!_morse.is_done())
+        next_event = _morse.get_next_event_time();
+    if(_in_inter_group_delay && _next_group_time < next_event)
+        next_event = _next_group_time;
+    return next_event;
+}
+
+// step() sends a signal meter charge pulse on every pass while the carrier is on
+unsigned long SimNumbers::get_wake_time(unsigned long time)
+{
+    if(_keyer.is_pending() || (!_morse.is_done() && _morse.is_switched_on()))
+        return time;
+    return get_next_event_time(time);
+}
 // JH! 
 
 void SimNumbers::generate_next_number_group()
@@ -242,5 +279,5 @@ void SimNumbers::apply_frequency_drift()
     float drift = ((float)random(0, (long)(2.0f * DRIFT_RANGE * 100))) / 100.0f - DRIFT_RANGE;
     
     // Apply drift to the base class frequency - the station will use this on next cycle
-    _fixed_freq = _fixed_freq + drift;
+    set_fixed_frequency(_fixed_freq + drift);
 }
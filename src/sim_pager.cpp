@@ -50,14 +50,14 @@ void SimPager::realize()
         switch(_pager.get_current_state()) {
             case PAGER_STATE_TONE_A:
                 // Transmit Tone A (longer unsquelch tone)
-                wavegen->set_frequency(_frequency + _current_tone_a_offset, true);
-                wavegen->set_frequency(_frequency + _current_tone_a_offset, false);
+                wavegen->set_frequency(audio_frequency() + _current_tone_a_offset, true);
+                wavegen->set_frequency(audio_frequency() + _current_tone_a_offset, false);
                 break;
                 
             case PAGER_STATE_TONE_B:
                 // Transmit Tone B (shorter identification tone)
-                wavegen->set_frequency(_frequency + _current_tone_b_offset, true);
-                wavegen->set_frequency(_frequency + _current_tone_b_offset, false);
+                wavegen->set_frequency(audio_frequency() + _current_tone_b_offset, true);
+                wavegen->set_frequency(audio_frequency() + _current_tone_b_offset, false);
                 break;
                   default:
                 // Silent state (SILENCE) - should not reach here when _active is true
@@ -145,6 +145,24 @@ bool SimPager::step(unsigned long time)
     return true;
 }
 
+unsigned long SimPager::get_next_event_time(unsigned long time)
+{
+    if (!_pager.is_running()) {
+        return NO_PENDING_EVENT;
+    }
+    unsigned long next_event = _pager.get_next_event_time();
+    return (next_event == 0) ? time : next_event;
+}
+
+// step() sends a signal meter charge pulse on every pass while a tone is on
+unsigned long SimPager::get_wake_time(unsigned long time)
+{
+    if (_pager.is_running() && _pager.get_current_state() != PAGER_STATE_SILENCE) {
+        return time;
+    }
+    return get_next_event_time(time);
+}
+
 void SimPager::generate_new_tone_pair()
 {
     // Generate random tone pair similar to DTMF frequencies
@@ -77,13 +77,9 @@ bool SimPager2::begin(unsigned long time)
     WaveGen *wavegen = _wave_gen_pool->access_realizer(_realizer);
     WaveGen *wavegen_b = _wave_gen_pool->access_realizer(_realizer_b);
 
-    // Initialize first generator channels to silent
-    wavegen->set_frequency(SILENT_FREQ, false);
-    wavegen->set_frequency(SILENT_FREQ, true);
-    
-    // Initialize second generator channels to silent
-    wavegen_b->set_frequency(SILENT_FREQ, false);
-    wavegen_b->set_frequency(SILENT_FREQ, true);
+    // Initialize all four channels to silent in one broadcast
+    WaveGen *wavegens[2] = {wavegen, wavegen_b};
+    WaveGen::silence(wavegens, 2);
 #endif
 
     return true;
@@ -109,14 +105,14 @@ void SimPager2::realize()
         switch(_pager.get_current_state()) {
             case PAGER_STATE_TONE_A:
                 // Transmit Tone A (longer unsquelch tone)
-                wavegen->set_frequency(_frequency + _current_tone_a_offset, true);
-                wavegen->set_frequency(_frequency + _current_tone_a_offset, false);
+                wavegen->set_frequency(audio_frequency() + _current_tone_a_offset, true);
+                wavegen->set_frequency(audio_frequency() + _current_tone_a_offset, false);
                 break;
                 
             case PAGER_STATE_TONE_B:
                 // Transmit Tone B (shorter identification tone)
-                wavegen->set_frequency(_frequency + _current_tone_b_offset, true);
-                wavegen->set_frequency(_frequency + _current_tone_b_offset, false);
+                wavegen->set_frequency(audio_frequency() + _current_tone_b_offset, true);
+                wavegen->set_frequency(audio_frequency() + _current_tone_b_offset, false);
                 break;
                   default:
                 // Silent state (SILENCE) - should not reach here when _active is true
@@ -146,14 +142,14 @@ void SimPager2::realize()
         switch(_pager.get_current_state()) {
             case PAGER_STATE_TONE_A:
                 // Transmit Tone A (longer unsquelch tone) - second generator frequencies
-                wavegen_b->set_frequency(_frequency + _current_tone_a_offset_b, true);
-                wavegen_b->set_frequency(_frequency + _current_tone_a_offset_b, false);
+                wavegen_b->set_frequency(audio_frequency() + _current_tone_a_offset_b, true);
+                wavegen_b->set_frequency(audio_frequency() + _current_tone_a_offset_b, false);
                 break;
                 
             case PAGER_STATE_TONE_B:
                 // Transmit Tone B (shorter identification tone) - second generator frequencies
-                wavegen_b->set_frequency(_frequency + _current_tone_b_offset_b, true);
-                wavegen_b->set_frequency(_frequency + _current_tone_b_offset_b, false);
+                wavegen_b->set_frequency(audio_frequency() + _current_tone_b_offset_b, true);
+                wavegen_b->set_frequency(audio_frequency() + _current_tone_b_offset_b, false);
                 break;
                   default:
                 // Silent state (SILENCE) - should not reach here when _active is true
@@ -178,42 +174,37 @@ void SimPager2::realize()
     
     WaveGen *wavegen = _wave_gen_pool->access_realizer(_realizer);
     WaveGen *wavegen_b = _wave_gen_pool->access_realizer(_realizer_b);
+    WaveGen *wavegens[2] = {wavegen, wavegen_b};
     
     if(_active) {
         // Set frequencies for BOTH generators based on current pager state
         switch(_pager.get_current_state()) {
             case PAGER_STATE_TONE_A:
                 // FIRST GENERATOR: Transmit Tone A
-                wavegen->set_frequency(_frequency + _current_tone_a_offset, true);
-                wavegen->set_frequency(_frequency + _current_tone_a_offset, false);
+                wavegen->set_frequency(audio_frequency() + _current_tone_a_offset, true);
+                wavegen->set_frequency(audio_frequency() + _current_tone_a_offset, false);
                 
                 // SECOND GENERATOR: Transmit its own Tone A (different frequency)
-                wavegen_b->set_frequency(_frequency + _current_tone_a_offset_b, true);
-                wavegen_b->set_frequency(_frequency + _current_tone_a_offset_b, false);
+                wavegen_b->set_frequency(audio_frequency() + _current_tone_a_offset_b, true);
+                wavegen_b->set_frequency(audio_frequency() + _current_tone_a_offset_b, false);
                 break;
                 
             case PAGER_STATE_TONE_B:
                 // FIRST GENERATOR: Transmit Tone B
-                wavegen->set_frequency(_frequency + _current_tone_b_offset, true);
-                wavegen->set_frequency(_frequency + _current_tone_b_offset, false);
+                wavegen->set_frequency(audio_frequency() + _current_tone_b_offset, true);
+                wavegen->set_frequency(audio_frequency() + _current_tone_b_offset, false);
                 
                 // SECOND GENERATOR: Transmit its own Tone B (different frequency)
-                wavegen_b->set_frequency(_frequency + _current_tone_b_offset_b, true);
-                wavegen_b->set_frequency(_frequency + _current_tone_b_offset_b, false);
+                wavegen_b->set_frequency(audio_frequency() + _current_tone_b_offset_b, true);
+                wavegen_b->set_frequency(audio_frequency() + _current_tone_b_offset_b, false);
                 break;
                   default:
                 // Silent state for both generators
-                wavegen->set_frequency(SILENT_FREQ, true);
-                wavegen->set_frequency(SILENT_FREQ, false);
-                wavegen_b->set_frequency(SILENT_FREQ, true);
-                wavegen_b->set_frequency(SILENT_FREQ, false);
+                WaveGen::silence(wavegens, 2);
                 break;
         }    } else {
         // Both generators silent when inactive
-        wavegen->set_frequency(SILENT_FREQ, true);
-        wavegen->set_frequency(SILENT_FREQ, false);
-        wavegen_b->set_frequency(SILENT_FREQ, true);
-        wavegen_b->set_frequency(SILENT_FREQ, false);
+        WaveGen::silence(wavegens, 2);
     }
     
     // Activate/deactivate both generators together
@@ -360,6 +351,24 @@ bool SimPager2::step(unsigned long time)
     return true;
 }
 
+unsigned long SimPager2::get_next_event_time(unsigned long time)
+{
+    if (!_pager.is_running()) {
+        return NO_PENDING_EVENT;
+    }
+    unsigned long next_event = _pager.get_next_event_time();
+    return (next_event == 0) ? time : next_event;
+}
+
+// step() sends a signal meter charge pulse on every pass while a tone is on
+unsigned long SimPager2::get_wake_time(unsigned long time)
+{
+    if (_pager.is_running() && _pager.get_current_state() != PAGER_STATE_SILENCE) {
+        return time;
+    }
+    return get_next_event_time(time);
+}
+
 void SimPager2::generate_new_tone_pair()
 {
     // Generate DTMF digit pairs for both generators
@@ -9,7 +9,7 @@ static const char rtty_message[] = "CQ CQ DE N6CCM K       ";
 
 // mode is expected to be a derivative of VFO
 SimRTTY::SimRTTY(WaveGenPool *wave_gen_pool, SignalMeter *signal_meter, float fixed_freq) 
-    : SimTransmitter(wave_gen_pool, fixed_freq), _signal_meter(signal_meter)
+    : SimTransmitter(wave_gen_pool, fixed_freq), _keyer(&_rtty), _signal_meter(signal_meter)
 {
     // Initialize message cycling state - start with initial MARK tone
     _in_wait_delay = true;
@@ -46,15 +46,20 @@ bool SimRTTY::begin(unsigned long time){
 
 void SimRTTY::realize(){
     if(!check_frequency_bounds()) {
+        _keyer.set_output(NULL);
         return;  // Out of audible range
     }
     
     // RESOURCE MANAGEMENT: Check if we have a wave generator
     if (_realizer == -1) {
+        _keyer.set_output(NULL);
         return;  // No resource available - station is dormant
     }
       WaveGen *wavegen = _wave_gen_pool->access_realizer(_realizer);
     
+    // The tick only keys the generator while a message can be running
+    _keyer.set_output(_in_round_break ? NULL : wavegen);
+
     if(_in_round_break) {
         // During long silent period between rounds, force both channels to silent frequency
         wavegen->set_frequency(SILENT_FREQ, true);
@@ -62,18 +67,31 @@ void SimRTTY::realize(){
         wavegen->set_active_frequency(false);
     } else {
         // Normal RTTY operation or short MARK delay between repetitions
-        wavegen->set_active_frequency(_active);
+        if(!_keyer.is_keying())
+            wavegen->set_active_frequency(_active);
     }
 }
 
+// the generator is about to go back to the pool; stop the tick keying it
+void SimRTTY::end(){
+    _keyer.set_output(NULL);
+    SimTransmitter::end();
+}
+
+void SimRTTY::start_message(){
+    _keyer.hold();
+    _rtty.start_rtty_message(rtty_message, false);
+    _keyer.release();
+}
+
 // returns true on successful update
 bool SimRTTY::update(Mode *mode){
     common_frequency_update(mode);    
     
     if(_enabled && _realizer != -1){  // RESOURCE MANAGEMENT: Check if we have a wave generator
         WaveGen *wavegen = _wave_gen_pool->access_realizer(_realizer);
-        wavegen->set_frequency(_frequency, true);
-        wavegen->set_frequency(_frequency + MARK_FREQ_SHIFT, false);
+        wavegen->set_frequency_word(WaveGen::tuning_word_dhz(_frequency_dhz), true);
+        wavegen->set_frequency_word(WaveGen::tuning_word_dhz(_frequency_dhz + MARK_SHIFT_DHZ), false);
     }
 
     realize();
@@ -104,7 +122,7 @@ bool SimRTTY::step(unsigned long time){
             if (_in_initial_mark) {
                 _in_initial_mark = false;
                 // After initial MARK, start the first message
-                _rtty.start_rtty_message(rtty_message, false);
+                start_message();
                 return true;
             }
             
@@ -139,8 +157,8 @@ bool SimRTTY::step(unsigned long time){
             // Note: This happens when we already have a realizer and just exited round break
             if(_enabled && _realizer != -1){
                 WaveGen *wavegen = _wave_gen_pool->access_realizer(_realizer);
-                wavegen->set_frequency(_frequency, true);  // SPACE frequency (channel 1)
-                wavegen->set_frequency(_frequency + MARK_FREQ_SHIFT, false);  // MARK frequency (channel 0)
+                wavegen->set_frequency_word(WaveGen::tuning_word_dhz(_frequency_dhz), true);  // SPACE frequency (channel 1)
+                wavegen->set_frequency_word(WaveGen::tuning_word_dhz(_frequency_dhz + MARK_SHIFT_DHZ), false);  // MARK frequency (channel 0)
             }
             
             // Start next message after wait delay completes (but set up initial MARK for new round)
@@ -160,8 +178,8 @@ bool SimRTTY::step(unsigned long time){
                     // RTTY also needs the MARK frequency set up
                     if(_enabled && _realizer != -1) {
                         WaveGen *wavegen = _wave_gen_pool->access_realizer(_realizer);
-                        wavegen->set_frequency(_frequency, true);  // SPACE frequency
-                        wavegen->set_frequency(_frequency + MARK_FREQ_SHIFT, false);  // MARK frequency
+                        wavegen->set_frequency_word(WaveGen::tuning_word_dhz(_frequency_dhz), true);  // SPACE frequency
+                        wavegen->set_frequency_word(WaveGen::tuning_word_dhz(_frequency_dhz + MARK_SHIFT_DHZ), false);  // MARK frequency
                     }
                 }
                 
@@ -171,7 +189,7 @@ bool SimRTTY::step(unsigned long time){
                 _next_message_time = time + (RTTY_MARK_TONE_SECONDS * 1000);  // Initial MARK tone
             } else {
                 // Continue with next message in current round
-                _rtty.start_rtty_message(rtty_message, false);
+                start_message();
             }
         }
         return true;
@@ -179,7 +197,7 @@ bool SimRTTY::step(unsigned long time){
     
     // Process RTTY state machine only when not in wait delay and we have a wave generator
     if (_realizer != -1) {  // RESOURCE MANAGEMENT: Only process when we have a resource
-        switch(_rtty.step_rtty(time)){
+        switch(_keyer.step(time)){
         	case STEP_RTTY_TURN_ON:
                 _active = true;
                 realize();
@@ -222,3 +240,23 @@ bool SimRTTY::step(unsigned long time){
 
     return true;
 }
+
+// the wait delay suspends the modulator, which also only runs while holding a wave generator
+unsigned long SimRTTY::get_next_event_time(unsigned long time){
+    if (_in_wait_delay) {
+        return _next_message_time;
+    }
+    if (_realizer != -1 && !_rtty.is_message_complete()) {
+        return _rtty.get_next_event_time();
+    }
+    return NO_PENDING_EVENT;
+}
+
+// step() sends a signal meter charge pulse on every pass while the carrier is on,
+// and keys the MARK tone (or unkeys for a round break) on the first pass of a wait
+unsigned long SimRTTY::get_wake_time(unsigned long time){
+    if (_in_wait_delay ? (_active == _in_round_break) : (_realizer != -1 && (_keyer.is_pending() || _rtty.is_switched_on()))) {
+        return time;
+    }
+    return get_next_event_time(time);
+}
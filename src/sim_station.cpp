@@ -20,7 +20,7 @@
 
 // mode is expected to be a derivative of VFO
 SimStation::SimStation(WaveGenPool *wave_gen_pool, SignalMeter *signal_meter, float fixed_freq, int wpm)
-    : SimTransmitter(wave_gen_pool, fixed_freq), _signal_meter(signal_meter), _stored_wpm(wpm), _base_wpm(wpm)
+    : SimTransmitter(wave_gen_pool, fixed_freq), _keyer(&_morse), _signal_meter(signal_meter), _stored_wpm(wpm), _base_wpm(wpm)
 {
     // Initialize operator frustration drift tracking
     _cycles_completed = 0;
@@ -38,7 +38,7 @@ SimStation::SimStation(WaveGenPool *wave_gen_pool, SignalMeter *signal_meter, fl
 }
 
 SimStation::SimStation(WaveGenPool *wave_gen_pool, SignalMeter *signal_meter, float fixed_freq, int wpm, byte fist_quality)
-    : SimTransmitter(wave_gen_pool, fixed_freq), _signal_meter(signal_meter), _stored_wpm(wpm), _base_wpm(wpm)
+    : SimTransmitter(wave_gen_pool, fixed_freq), _keyer(&_morse), _signal_meter(signal_meter), _stored_wpm(wpm), _base_wpm(wpm)
 {
     // Initialize operator frustration drift tracking    // Initialize operator frustration drift tracking
     _cycles_completed = 0;
@@ -73,7 +73,9 @@ bool SimStation::begin(unsigned long time){
     realize();  // CRITICAL: Set active state for audio output!
 
     // Start first CQ immediately (after frequencies are set)
+    _keyer.hold();
     _morse.start_morse(_generated_message, _stored_wpm);
+    _keyer.release();
     _in_wait_delay = false;
 
     return true;
@@ -81,15 +83,25 @@ bool SimStation::begin(unsigned long time){
 
 void SimStation::realize(){
     if(_realizer == -1) {
+        _keyer.set_output(NULL);
         return;  // No WaveGen allocated
     }
 
     if(!check_frequency_bounds()) {
+        _keyer.set_output(NULL);
         return;  // Out of audible range
     }
 
     WaveGen *wavegen = _wave_gen_pool->access_realizer(_realizer);
-    wavegen->set_active_frequency(_active);
+    _keyer.set_output(wavegen);
+    if(!_keyer.is_keying())
+        wavegen->set_active_frequency(_active);
+}
+
+// the generator is about to go back to the pool; stop the tick keying it
+void SimStation::end(){
+    _keyer.set_output(NULL);
+    SimTransmitter::end();
 }
 
 // returns true on successful update
@@ -98,7 +110,7 @@ bool SimStation::update(Mode *mode){
 
     if(_enabled && _realizer != -1){
         WaveGen *wavegen = _wave_gen_pool->access_realizer(_realizer);
-        wavegen->set_frequency(_frequency);
+        wavegen->set_frequency_word(WaveGen::tuning_word_dhz(_frequency_dhz));
     }
 
     realize();
@@ -110,7 +122,7 @@ bool SimStation::update(Mode *mode){
 // returns true if it should keep going
 bool SimStation::step(unsigned long time){
     // Handle morse code timing
-    int morse_state = _morse.step_morse(time);
+    int morse_state = _keyer.step(time);
       switch(morse_state){
     	case STEP_MORSE_TURN_ON:
             _active = true;
@@ -167,10 +179,28 @@ bool SimStation::step(unsigned long time){
     return true;
 }
 
+// earliest of the next Morse element and the end of the wait between CQs
+unsigned long SimStation::get_next_event_time(unsigned long time){
+    unsigned long next_event = NO_PENDING_EVENT;
+    if(!_morse.is_done())
+        next_event = _morse.get_next_event_time();
+    if(_in_wait_delay && _next_cq_time < next_event)
+        next_event = _next_cq_time;
+    return next_event;
+}
+
+// step() sends a signal meter charge pulse on every pass while the carrier is on
+unsigned long SimStation::get_wake_time(unsigned long time){
+    if(_keyer.is_pending() || (!_morse.is_done() && _morse.is_switched_on()))
+        return time;
+    return get_next_event_time(time);
+}
+
 // Set station into retry state (used when initialization fails)
 void SimStation::set_retry_state(unsigned long next_try_time) {
     _in_wait_delay = true;
     _next_cq_time = next_try_time;
+    wake();
 }
 
 // Use base class end() method for cleanup
@@ -228,7 +258,7 @@ void SimStation::apply_operator_frustration_drift()
     float drift = ((float)random(0, (long)(2.0f * DRIFT_RANGE * 100))) / 100.0f - DRIFT_RANGE;
 
     // Apply drift to the base class frequency
-    _fixed_freq = _fixed_freq + drift;
+    set_fixed_frequency(_fixed_freq + drift);
       // ENHANCEMENT: Generate new callsign to simulate a completely different operator
     // This makes it appear that a new station has come on frequency instead of
     // the same operator continuing to call CQ after frequency adjustment
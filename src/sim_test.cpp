@@ -75,9 +75,9 @@ void SimTest::realize()
             tone_offset = _current_tone_b_offset;  // Use configured tone B
         }
         
-        // Use the working SimPager method: _frequency + offset
-        wavegen->set_frequency(_frequency + tone_offset, true);
-        wavegen->set_frequency(_frequency + tone_offset, false);
+        // Use the working SimPager method: audio_frequency() + offset
+        wavegen->set_frequency(audio_frequency() + tone_offset, true);
+        wavegen->set_frequency(audio_frequency() + tone_offset, false);
     } else {
         // Explicitly set silent frequencies when inactive
         wavegen->set_frequency(SILENT_FREQ, true);
@@ -158,3 +158,9 @@ void SimTest::debug_print_tone_pair() const
 {
     // Debug output not needed for Arduino build
 }
+
+// step() toggles and feeds the signal meter on every pass - that is the test
+unsigned long SimTest::get_wake_time(unsigned long time)
+{
+    return time;
+}
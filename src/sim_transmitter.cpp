@@ -7,11 +7,12 @@ SimTransmitter::SimTransmitter(WaveGenPool *wave_gen_pool, float fixed_freq)
     : Realization(wave_gen_pool, (int)(fixed_freq / 1000))  // Pass frequency in kHz as station ID
 {
     // Initialize common member variables
-    _fixed_freq = fixed_freq;
+    set_fixed_frequency(fixed_freq);
     _enabled = false;
-    _frequency = 0.0;
+    _frequency_dhz = 0;
     _active = false;
     _vfo_freq = 0.0;  // Initialize VFO frequency to prevent garbage values
+    _vfo_dhz = 0;
     
     // Initialize dynamic station management state
     _station_state = DORMANT;
@@ -19,8 +20,8 @@ SimTransmitter::SimTransmitter(WaveGenPool *wave_gen_pool, float fixed_freq)
 
 bool SimTransmitter::common_begin(unsigned long time, float fixed_freq)
 {
-    _fixed_freq = fixed_freq;
-    _frequency = 0.0;
+    set_fixed_frequency(fixed_freq);
+    _frequency_dhz = 0;
     
     // Update station ID for debugging (frequency in kHz)
     set_station_id((int)(fixed_freq / 1000));
@@ -33,17 +34,25 @@ void SimTransmitter::common_frequency_update(Mode *mode)
     // Note: mode is expected to be a VFO object
     VFO *vfo = static_cast<VFO*>(mode);
     _vfo_freq = float(vfo->_frequency) + (vfo->_sub_frequency / 10.0);
-    
-    // Calculate raw frequency difference (used for signal meter - no BFO offset)
-    float raw_frequency = _vfo_freq - _fixed_freq;
-      // Add BFO offset for comfortable audio tuning
+    _vfo_dhz = vfo->_frequency * 10UL + vfo->_sub_frequency;
+
+    // Audio frequency in tenths of a hertz, integer from the VFO through to
+    // the tuning word. Add BFO offset for comfortable audio tuning
     // This shifts the audio frequency without affecting signal meter calculations
-    _frequency = raw_frequency + option_bfo_offset;
+    _frequency_dhz = (long)(_vfo_dhz - _fixed_dhz) + option_bfo_offset * 10L;
+}
+
+void SimTransmitter::set_fixed_frequency(float fixed_freq)
+{
+    _fixed_freq = fixed_freq;
+    // Whole hertz first: 70,000,000 tenths is past a float's 24-bit mantissa,
+    // so fixed_freq * 10.0f would land on a multiple of 8 tenths
+    _fixed_dhz = (unsigned long)(fixed_freq + 0.5f) * 10UL;
 }
 
 bool SimTransmitter::check_frequency_bounds()
 {
-    if(_frequency > MAX_AUDIBLE_FREQ || _frequency < MIN_AUDIBLE_FREQ){
+    if(_frequency_dhz > MAX_AUDIBLE_DHZ || _frequency_dhz < MIN_AUDIBLE_DHZ){
         if(_enabled){
             _enabled = false;
 
@@ -88,14 +97,15 @@ bool SimTransmitter::reinitialize(unsigned long time, float fixed_freq)
     end();  // Safe to call multiple times
     
     // Set new parameters
-    _fixed_freq = fixed_freq;
-    _frequency = 0.0;
+    set_fixed_frequency(fixed_freq);
+    _frequency_dhz = 0;
     _enabled = false;
     _active = false;
     _station_state = ACTIVE;  // Station is now active at new frequency
     
     // Start the station with the new frequency
     bool success = begin(time);
+    wake();
     
     // Subclasses should override this method to reinitialize their specific content
     // (e.g., new morse messages, different WPM, new pager content, etc.)
@@ -114,6 +124,7 @@ void SimTransmitter::set_station_state(StationState new_state)
 {
     StationState old_state = _station_state;
     _station_state = new_state;
+    wake();
     
     // Handle state transition logic
     if(old_state == AUDIBLE && new_state != AUDIBLE) {
@@ -143,6 +154,7 @@ float SimTransmitter::get_fixed_frequency() const
 
 void SimTransmitter::setActive(bool active) {
     _active = active;
+    wake();
 }
 
 bool SimTransmitter::isActive() const {
@@ -151,7 +163,7 @@ bool SimTransmitter::isActive() const {
 
 void SimTransmitter::force_frequency_update()
 {
-    // Immediately recalculate _frequency and update wave generator
+    // Immediately recalculate _frequency_dhz and update wave generator
     // This is used when _fixed_freq changes outside of the normal update() cycle
     // (e.g., frequency drift, dynamic station reallocation)
     // 
@@ -164,11 +176,10 @@ void SimTransmitter::force_frequency_update()
     // VFO proximity), this method should be made more defensive and frequency
     // changes should be deferred until a generator is re-allocated.
     if(_enabled && _realizer != -1) {
-        // Recalculate _frequency with current _fixed_freq and _vfo_freq
-        float raw_frequency = _vfo_freq - _fixed_freq;
-        _frequency = raw_frequency + option_bfo_offset;
+        // Recalculate _frequency_dhz with current _fixed_dhz and _vfo_dhz
+        _frequency_dhz = (long)(_vfo_dhz - _fixed_dhz) + option_bfo_offset * 10L;
           // Update the wave generator with the new frequency
         WaveGen *wavegen = _wave_gen_pool->access_realizer(_realizer);
-        wavegen->set_frequency(_frequency);
+        wavegen->set_frequency_word(WaveGen::tuning_word_dhz(_frequency_dhz));
     }
 }
\ No newline at end of file
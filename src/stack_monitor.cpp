@@ -0,0 +1,149 @@
+#include "stack_monitor.h"
+#include "buffers.h"
+
+#ifdef __AVR__
+extern char __heap_start;
+extern char *__brkval;
+#endif
+
+StackMonitor::StackMonitor()
+{
+    _mark = 0;
+    _scan = 0;
+    _low_phase = STACK_PHASE_SETUP;
+    _lows = 0;
+    _painted = 0;
+    _showing = false;
+    _next_display = 0;
+}
+
+uint8_t *StackMonitor::heap_end()
+{
+#ifdef __AVR__
+    return (uint8_t *)(__brkval ? __brkval : &__heap_start);
+#else
+    return 0;
+#endif
+}
+
+void StackMonitor::paint()
+{
+#ifdef __AVR__
+    uint8_t *bottom = heap_end();
+    uint8_t *top = (uint8_t *)SP - STACK_MONITOR_PAINT_MARGIN;
+    if (top <= bottom) return;
+
+    for (uint8_t *p = bottom; p < top; p++) {
+        *p = STACK_CANARY;
+    }
+    _painted = top - bottom;
+    _mark = top;
+    _scan = bottom;
+#endif
+}
+
+void StackMonitor::new_low(uint8_t *mark, byte phase)
+{
+    _mark = mark;
+    _low_phase = phase;
+    _lows++;
+}
+
+void StackMonitor::check(byte phase)
+{
+    if (!_mark) return;
+
+    uint8_t *bottom = heap_end();
+    uint8_t *probe = _mark;
+    uint8_t *lowest = _mark;
+    for (byte i = 0; i < STACK_MONITOR_PROBE_BYTES && probe > bottom; i++) {
+        probe--;
+        if (*probe != STACK_CANARY) lowest = probe;
+    }
+    if (lowest == _mark) return;
+
+    // Follow the overwritten run down to the new mark
+    while (lowest > bottom && *(lowest - 1) != STACK_CANARY) {
+        lowest--;
+    }
+    new_low(lowest, phase);
+}
+
+void StackMonitor::step(unsigned long time, HT16K33Disp *display)
+{
+    if (!_mark) return;
+
+    uint8_t *bottom = heap_end();
+    if (_scan < bottom || _scan >= _mark) _scan = bottom;
+
+    for (byte i = 0; i < STACK_MONITOR_SCAN_BYTES && _scan < _mark; i++, _scan++) {
+        if (*_scan != STACK_CANARY) {
+            new_low(_scan, STACK_PHASE_SCAN);
+            break;
+        }
+    }
+
+    if (_showing && display && time >= _next_display) {
+        _next_display = time + STACK_MONITOR_DISPLAY_MS;
+        // "S1234 P3": least free bytes and the phase that set it
+        sprintf(display_text_buffer, "S%4u P%c", get_min_free(),
+                _low_phase < LOOP_PROFILER_PHASES ? (char)('0' + _low_phase) : '-');
+        display->show_string(display_text_buffer);
+    }
+}
+
+unsigned int StackMonitor::get_min_free() const
+{
+    if (!_mark) return 0;
+    uint8_t *bottom = heap_end();
+    return _mark > bottom ? _mark - bottom : 0;
+}
+
+bool StackMonitor::handle_command(char command)
+{
+    switch (command) {
+        case 's':
+        case 'S':
+            print_report();
+            return true;
+        case 'd':
+        case 'D':
+            _showing = !_showing;
+            _next_display = 0;
+            return true;
+    }
+    return false;
+}
+
+void StackMonitor::print_phase_name(byte phase)
+{
+    switch (phase) {
+        case LOOP_PHASE_SIGNAL_METER:     Serial.print(F("meter")); break;
+        case LOOP_PHASE_STATION_MANAGER:  Serial.print(F("stations")); break;
+        case LOOP_PHASE_PANEL_LED:        Serial.print(F("panelled")); break;
+        case LOOP_PHASE_REALIZATION_POOL: Serial.print(F("realize")); break;
+        case LOOP_PHASE_ENCODERS:         Serial.print(F("encoders")); break;
+        case LOOP_PHASE_TITLE_DISPLAY:    Serial.print(F("title")); break;
+        case LOOP_PHASE_DISPATCH:         Serial.print(F("dispatch")); break;
+        case STACK_PHASE_SETUP:           Serial.print(F("setup")); break;
+        case STACK_PHASE_SCAN:            Serial.print(F("scan")); break;
+        default:                          Serial.print(phase); break;
+    }
+}
+
+void StackMonitor::print_report()
+{
+    if (!_mark) {
+        Serial.println(F("stack monitor inactive"));
+        return;
+    }
+    Serial.print(F("stack painted "));
+    Serial.print(_painted);
+    Serial.print(F(" min free "));
+    Serial.print(get_min_free());
+    Serial.print(F(" lows "));
+    Serial.print(_lows);
+    Serial.print(F(" last low in "));
+    print_phase_name(_low_phase);
+    Serial.println();
+}
@@ -17,6 +17,7 @@ StationManager::StationManager(SimTransmitter** station_ptrs, int station_count)
     pipeline_center_freq = 0;
     tuning_direction = 0;
     last_tuning_time = 0;
+    relocation_count = 0;
 }
 
 void StationManager::updateStations(uint32_t vfo_freq) {
@@ -191,7 +192,7 @@ void StationManager::updatePipeline(uint32_t vfo_freq) {
         Serial.println(tuning_direction);
         #endif
     }
-    else if (current_time - last_tuning_time > 5000) { // 5 second settle time - longer to allow listening
+    else if (current_time - last_tuning_time > PIPELINE_SETTLE_MS) {
         // User has stopped tuning - pause pipeline updates
         if (tuning_direction != 0) {
             tuning_direction = 0;
@@ -202,6 +203,12 @@ void StationManager::updatePipeline(uint32_t vfo_freq) {
     }
 }
 
+unsigned long StationManager::getNextEventTime() const {
+    // The only time-driven change is the settle-time pause in updatePipeline()
+    if (!pipeline_enabled || tuning_direction == 0) return NO_PENDING_EVENT;
+    return last_tuning_time + PIPELINE_SETTLE_MS + 1;
+}
+
 void StationManager::reallocateStations(uint32_t vfo_freq) {
     #ifdef DEBUG_PIPELINING
     Serial.print("reallocate called, dir=");
@@ -301,12 +308,12 @@ void StationManager::reallocateStations(uint32_t vfo_freq) {
         
         if (tuning_direction > 0) {
             // Tuning up - move stations ahead of VFO (higher frequencies)
-            new_freq = vfo_freq + 2000 + (stations_moved * 1000); // 2-6 kHz ahead
+            new_freq = vfo_freq + PIPELINE_PLACE_UP_OFFSET + (stations_moved * PIPELINE_PLACE_UP_STEP); // 2-6 kHz ahead
         } else {
             // Tuning down - place stations BELOW VFO so they can be dialed into
             // As VFO frequency decreases (tuning down), user will eventually tune into these stations
             // Place them 5.7-7.2 kHz below VFO so they start inaudible but become audible as user tunes down
-            new_freq = vfo_freq - 5700 - (stations_moved * 500); // 5.7-7.2 kHz behind (below VFO)
+            new_freq = vfo_freq - PIPELINE_PLACE_DOWN_OFFSET - (stations_moved * PIPELINE_PLACE_DOWN_STEP); // 5.7-7.2 kHz behind (below VFO)
         }
         
         // Ensure we don't go below minimum frequency
@@ -319,6 +326,7 @@ void StationManager::reallocateStations(uint32_t vfo_freq) {
         stations[i]->randomize();
         
         stations_moved++;
+        relocation_count++;
         
         #ifdef DEBUG_PIPELINING
         Serial.print("MOVE: S");
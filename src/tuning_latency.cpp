@@ -0,0 +1,113 @@
+#include "tuning_latency.h"
+
+TuningLatency::TuningLatency()
+{
+    reset();
+    _open = false;
+    _detent_time = 0;
+    _last_write = 0;
+    _written = false;
+}
+
+void TuningLatency::begin(unsigned long detent_time)
+{
+    _open = true;
+    _detent_time = detent_time;
+    _written = false;
+}
+
+void TuningLatency::mark_write()
+{
+    if (!_open) return;
+    _last_write = micros();
+    _written = true;
+}
+
+void TuningLatency::end()
+{
+    if (!_open) return;
+    _open = false;
+    if (_written) {
+        record(_last_write - _detent_time);
+    } else {
+        _silent++;
+    }
+}
+
+void TuningLatency::record(unsigned long latency)
+{
+    unsigned long bucket = latency / TUNING_LATENCY_BUCKET_US;
+    if (bucket >= TUNING_LATENCY_BUCKETS) bucket = TUNING_LATENCY_BUCKETS - 1;
+
+    if (_buckets[bucket] == 0xFFFF) {
+        // Halve the whole histogram rather than clip one bucket
+        for (byte i = 0; i < TUNING_LATENCY_BUCKETS; i++) {
+            _buckets[i] >>= 1;
+        }
+    }
+    _buckets[bucket]++;
+
+    _count++;
+    _total += latency;
+    if (latency > _max) _max = latency;
+}
+
+void TuningLatency::reset()
+{
+    memset(_buckets, 0, sizeof(_buckets));
+    _count = 0;
+    _silent = 0;
+    _total = 0;
+    _max = 0;
+}
+
+unsigned long TuningLatency::get_percentile(byte percent) const
+{
+    unsigned long total = 0;
+    for (byte i = 0; i < TUNING_LATENCY_BUCKETS; i++) {
+        total += _buckets[i];
+    }
+    if (total == 0) return 0;
+
+    unsigned long threshold = (total * percent + 99) / 100;
+    unsigned long cumulative = 0;
+    for (byte i = 0; i < TUNING_LATENCY_BUCKETS - 1; i++) {
+        cumulative += _buckets[i];
+        if (cumulative >= threshold) {
+            unsigned long upper = (i + 1) * (unsigned long)TUNING_LATENCY_BUCKET_US - 1;
+            return upper < _max ? upper : _max;
+        }
+    }
+    return _max;
+}
+
+bool TuningLatency::handle_command(char command)
+{
+    switch (command) {
+        case 'l':
+        case 'L':
+            print_report();
+            return true;
+        case 'x':
+        case 'X':
+            reset();
+            Serial.println(F("latency reset"));
+            return true;
+    }
+    return false;
+}
+
+void TuningLatency::print_report()
+{
+    // Times in microseconds, detent seen to last AD9833 frequency write
+    Serial.print(F("tuning latency n "));
+    Serial.print(_count);
+    Serial.print(F(" mean "));
+    Serial.print(get_mean());
+    Serial.print(F(" p95<= "));
+    Serial.print(get_percentile(95));
+    Serial.print(F(" max "));
+    Serial.print(_max);
+    Serial.print(F(" silent "));
+    Serial.println(_silent);
+}
@@ -2,6 +2,7 @@
 #include "wavegen.h"
 #include "vfo.h"
 #include "buffers.h"
+#include "displays.h"
 #include "signal_meter.h"
 #include "station_config.h"
 #include "saved_data.h"  // For option_bfo_offset
@@ -39,7 +40,7 @@ void VFO::update_display(HT16K33Disp *display){
         // Display in Hz
         sprintf(display_text_buffer, "%8ld", _frequency);    }
 
-    display->show_string(display_text_buffer);
+    display_task.show(display_text_buffer);
 }
 
 void VFO::update_realization(){
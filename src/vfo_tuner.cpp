@@ -3,6 +3,25 @@
 
 VFO_Tuner::VFO_Tuner(Mode * mode) : ModeHandler(mode)
 {
+    _accelerate = true;
+    _last_tune_time = 0;
+}
+
+// step multiplier for a batch of detents, from the time per detent since
+// the previous batch
+unsigned long VFO_Tuner::accel_factor(int detents){
+    unsigned long now = millis();
+    unsigned long elapsed = now - _last_tune_time;
+    _last_tune_time = now;
+    if(!_accelerate)
+        return 1;
+
+    unsigned long count = detents < 0 ? -detents : detents;
+    if(elapsed <= TUNING_ACCEL_FAST_MS * count)
+        return TUNING_ACCEL_FAST_FACTOR;
+    if(elapsed <= TUNING_ACCEL_MEDIUM_MS * count)
+        return TUNING_ACCEL_MEDIUM_FACTOR;
+    return 1;
 }
 
 // does mode-specific handling of the event to modify the mode
@@ -10,15 +29,22 @@ VFO_Tuner::VFO_Tuner(Mode * mode) : ModeHandler(mode)
 bool VFO_Tuner::event_sink(int event, int event_data){
     VFO *vfo = (VFO*) _mode;
 
+    if(event == 0)
+        return true;
+
+    // event is the signed number of detents turned since the last pass
+    unsigned long count = event < 0 ? -event : event;
+    unsigned long delta = vfo->_step * accel_factor(event) * count;
+
     unsigned long _old_freq = vfo->_frequency;
-    if(event == 1){
-        vfo->_frequency += vfo->_step;
+    if(event > 0){
+        vfo->_frequency += delta;
         if(_old_freq > vfo->_frequency){
             // unsigned long wrapped up??
             vfo->_frequency = (unsigned long)-1L;
         }        
-    } else if(event == -1){
-        vfo->_frequency -= vfo->_step;
+    } else {
+        vfo->_frequency -= delta;
         if(_old_freq < vfo->_frequency){
             // unsigned long wrapped down??
             vfo->_frequency = 0;
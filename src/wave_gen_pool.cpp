@@ -6,6 +6,7 @@ WaveGenPool::WaveGenPool(WaveGen **wavegens, bool *statuses,  int nwavegens){
     _realizers = wavegens;
     _statuses = statuses;
     _nrealizers = nwavegens;
+    _failed_requests = 0;
 
     for(int i = 0; i < _nrealizers; i++){
         free_realizer(i, 0);  // Initialize with station_id 0
@@ -19,6 +20,7 @@ int WaveGenPool::get_realizer(int station_id){
             return i;
         }
     }
+    _failed_requests++;
     return -1;
 }
 
@@ -1,44 +1,180 @@
 #include <MD_AD9833.h>
 #include "wavegen.h"
+#include "tuning_latency.h"
 
 #define SILENT_FREQ 0.1
 
+// _dirty: staged changes not yet written by flush()
+#define DIRTY_MAIN 0x01
+#define DIRTY_ALT 0x02
+#define DIRTY_SELECT 0x04
+
+#ifdef ENABLE_MODULATION_TICK
+volatile bool WaveGen::_bus_busy = false;
+WaveGen *WaveGen::_first = NULL;
+#define BUS_ACQUIRE() acquire_bus()
+#define BUS_RELEASE() release_bus()
+#else
+#define BUS_ACQUIRE()
+#define BUS_RELEASE()
+#endif
+
 WaveGen::WaveGen(MD_AD9833 * sig_gen)
 {
     _sig_gen = sig_gen;
-	_frequency_main = SILENT_FREQ;
-	_frequency_alt = SILENT_FREQ;
+	_word_main = tuning_word(SILENT_FREQ);
+	_word_alt = tuning_word(SILENT_FREQ);
 	_main = true;
+	_dirty = 0;
+#ifdef ENABLE_MODULATION_TICK
+	_pending_key = -1;
+	_next = _first;
+	_first = this;
+#endif
 }
 
 void WaveGen::set_frequency(float frequency, bool main){
-	bool update = false;
-	if(main){
-		if(_frequency_main != frequency){
-			_frequency_main = frequency;
-			update = true;
-		}
-	} else {
-		if(_frequency_alt != frequency){
-			_frequency_alt = frequency;
-			update = true;
-		}
-	}
+	set_frequency_word(tuning_word(frequency), main);
+}
+
+void WaveGen::set_frequency_word(uint32_t word, bool main){
+	uint32_t &cached = main ? _word_main : _word_alt;
+	if(cached == word)
+		return;
+	cached = word;
+	_dirty |= main ? DIRTY_MAIN : DIRTY_ALT;
+}
+
+uint32_t WaveGen::tuning_word(float frequency){
+	return (frequency > 0) ? MD_AD9833::frequencyWord((uint32_t)(frequency * 10.0f + 0.5f)) : 0;
+}
 
-	if(update)
-		_sig_gen->setFrequency((MD_AD9833::channel_t)(main ? 0 : 1), frequency);
+uint32_t WaveGen::tuning_word_dhz(long frequency_dhz){
+	return (frequency_dhz > 0) ? MD_AD9833::frequencyWord((uint32_t)frequency_dhz) : 0;
 }
 
 void WaveGen::set_active_frequency(bool main){
-	_sig_gen->setActiveFrequency((MD_AD9833::channel_t)(main ? 0 : 1));
+	// With the modulation tick, key() has usually made this flip already
+	if(_main == main)
+		return;
 	_main = main;
+	_dirty |= DIRTY_SELECT;
 }
 
 void WaveGen::force_refresh(){
 	// Force hardware update regardless of cached state
 	// This is needed when returning to SimRadio after application switches
 	// that may have affected the AD9833 hardware state
-	_sig_gen->setFrequency((MD_AD9833::channel_t)(0), _frequency_main);
-	_sig_gen->setFrequency((MD_AD9833::channel_t)(1), _frequency_alt);
+	BUS_ACQUIRE();
+	_sig_gen->invalidate();
+	_sig_gen->setFrequencyWord((MD_AD9833::channel_t)(0), _word_main);
+	_sig_gen->setFrequencyWord((MD_AD9833::channel_t)(1), _word_alt);
 	_sig_gen->setActiveFrequency((MD_AD9833::channel_t)(_main ? 0 : 1));
+	_dirty = 0;
+	BUS_RELEASE();
+}
+
+void WaveGen::silence(WaveGen *wavegens[], byte count){
+	for(byte i = 0; i < count; i++){
+		wavegens[i]->set_frequency(SILENT_FREQ, true);
+		wavegens[i]->set_frequency(SILENT_FREQ, false);
+	}
+}
+
+// Channel words go before the FSELECT flips, so a flip never selects a
+// register still holding the previous word. Generators staging the same
+// word on the same channel (silence, mostly) get it in one broadcast; the
+// driver then only sends the halves that differ from what the chip holds.
+//
+// A keyed station's selected register is retuned in place: the driver's
+// writes never leave it holding a mix of old and new halves (see
+// setFrequencyWord()), and the other register is no spare to retune into,
+// it holds the key-up word.
+void WaveGen::flush(WaveGen *wavegens[], byte count){
+	bool written = false;
+
+	BUS_ACQUIRE();
+	for(byte channel = 0; channel < 2; channel++){
+		byte bit = channel == 0 ? DIRTY_MAIN : DIRTY_ALT;
+		for(byte i = 0; i < count; i++){
+			if(!(wavegens[i]->_dirty & bit))
+				continue;
+			uint32_t word = channel == 0 ? wavegens[i]->_word_main : wavegens[i]->_word_alt;
+
+			MD_AD9833 *chips[WAVEGEN_BROADCAST_MAX];
+			byte nchips = 0;
+			for(byte j = i; j < count; j++){
+				WaveGen *wavegen = wavegens[j];
+				if(!(wavegen->_dirty & bit) || (channel == 0 ? wavegen->_word_main : wavegen->_word_alt) != word)
+					continue;
+				wavegen->_dirty &= ~bit;
+				chips[nchips++] = wavegen->_sig_gen;
+				if(nchips == WAVEGEN_BROADCAST_MAX){
+					written |= MD_AD9833::setFrequencyWordAll(chips, nchips, (MD_AD9833::channel_t)channel, word);
+					nchips = 0;
+				}
+			}
+			written |= MD_AD9833::setFrequencyWordAll(chips, nchips, (MD_AD9833::channel_t)channel, word);
+		}
+	}
+
+	for(byte i = 0; i < count; i++){
+		WaveGen *wavegen = wavegens[i];
+		if(wavegen->_dirty & DIRTY_SELECT)
+			wavegen->_sig_gen->setActiveFrequency((MD_AD9833::channel_t)(wavegen->_main ? 0 : 1));
+		wavegen->_dirty = 0;
+	}
+	BUS_RELEASE();
+
+	if(written){
+		TUNING_LATENCY_WRITE();
+	}
+}
+
+#ifdef ENABLE_MODULATION_TICK
+// All four AD9833s share DATA and CLK, so while the main loop is part way
+// through any write the ISR must not start one of its own
+void WaveGen::key(bool main){
+	if(_bus_busy){
+		_pending_key = main ? 0 : 1;
+		return;
+	}
+	_pending_key = -1;
+	_sig_gen->setActiveFrequency((MD_AD9833::channel_t)(main ? 0 : 1));
+	_main = main;
+}
+
+void WaveGen::acquire_bus(){
+	_bus_busy = true;
+}
+
+// Apply flips the ISR deferred while the bus was held. More can be deferred
+// while those are written, so the bus is only let go once a check with
+// interrupts off finds none left.
+void WaveGen::release_bus(){
+	for(;;){
+		for(WaveGen *wavegen = _first; wavegen; wavegen = wavegen->_next){
+			noInterrupts();
+			int8_t channel = wavegen->_pending_key;
+			wavegen->_pending_key = -1;
+			interrupts();
+			if(channel < 0)
+				continue;
+			wavegen->_sig_gen->setActiveFrequency((MD_AD9833::channel_t)channel);
+			wavegen->_main = (channel == 0);
+		}
+
+		bool pending = false;
+		noInterrupts();
+		for(WaveGen *wavegen = _first; wavegen; wavegen = wavegen->_next){
+			if(wavegen->_pending_key >= 0)
+				pending = true;
+		}
+		if(!pending)
+			_bus_busy = false;
+		interrupts();
+		if(!pending)
+			return;
+	}
 }
+#endif